@@ -0,0 +1,85 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/testing/config.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace sofa::testing
+{
+
+/// Number of heap allocations done by the calling thread since its start.
+/// It is only incremented by the replacement operator new installed with SOFA_TESTING_COUNT_HEAP_ALLOCATIONS.
+SOFA_TESTING_API std::size_t& threadHeapAllocationCount();
+
+/** @brief Count the heap allocations done by the calling thread during its lifetime.
+ *
+ *  Usage:
+ *  @code
+ *  SOFA_TESTING_COUNT_HEAP_ALLOCATIONS()   // once per test executable, at global scope
+ *
+ *  TEST(MyComponent, noAllocationInSteadyState)
+ *  {
+ *      ...
+ *      ScopedHeapAllocationCounter counter;
+ *      component->addDForce(...);
+ *      EXPECT_EQ(counter.getCount(), 0u);
+ *  }
+ *  @endcode
+ *  The allocations of all the libraries loaded by the executable are counted on Linux and macOS,
+ *  where the replacement operator new of the executable is used by the whole process.
+ */
+class ScopedHeapAllocationCounter
+{
+public:
+    ScopedHeapAllocationCounter() : m_start(threadHeapAllocationCount()) {}
+
+    std::size_t getCount() const { return threadHeapAllocationCount() - m_start; }
+
+private:
+    std::size_t m_start;
+};
+
+} // namespace sofa::testing
+
+/// Replace the global operator new/delete of the executable by versions counting the allocations
+/// of each thread in sofa::testing::threadHeapAllocationCount(). Must be expanded once at global scope.
+#define SOFA_TESTING_COUNT_HEAP_ALLOCATIONS()                                          \
+    void* operator new(std::size_t size)                                               \
+    {                                                                                  \
+        ++sofa::testing::threadHeapAllocationCount();                                  \
+        if (void* p = std::malloc(size ? size : 1)) return p;                          \
+        throw std::bad_alloc();                                                        \
+    }                                                                                  \
+    void* operator new[](std::size_t size)                                             \
+    {                                                                                  \
+        ++sofa::testing::threadHeapAllocationCount();                                  \
+        if (void* p = std::malloc(size ? size : 1)) return p;                          \
+        throw std::bad_alloc();                                                        \
+    }                                                                                  \
+    void operator delete(void* p) noexcept { std::free(p); }                           \
+    void operator delete[](void* p) noexcept { std::free(p); }                         \
+    void operator delete(void* p, std::size_t) noexcept { std::free(p); }              \
+    void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
@@ -38,6 +38,8 @@
 #include <sofa/defaulttype/Vec.h>
 #include <sofa/defaulttype/VecTypes.h>
 
+#include <sofa/simulation/DefaultTaskScheduler.h>
+
 #include <gtest/gtest.h>
 
 
@@ -439,6 +441,78 @@ typedef TestSparseMatrices<SReal,4,8,2,2> Ts4822;
 //#undef TestMatrix
 
 
+/// Block products on FullVector (unrolled 3x3 kernel, multithreaded, upper triangle only)
+/// compared with the generic product
+struct TestCRSBlockProducts : public Sofa_test<SReal>
+{
+    typedef sofa::component::linearsolver::CompressedRowSparseMatrix< sofa::defaulttype::Mat<3,3,SReal> > CRSMatrix;
+    typedef sofa::component::linearsolver::FullVector<SReal> FullVector;
+
+    CRSMatrix crs, crsUpper;
+    FullVector vec, reference, result;
+
+    void SetUp() override
+    {
+        // symmetric banded matrix, large enough to be split among several threads
+        const sofa::Index nbBlockRows = 1000;
+        crs.resize(3 * nbBlockRows, 3 * nbBlockRows);
+        for (sofa::Index i = 0; i < nbBlockRows; ++i)
+        {
+            for (sofa::Index j = i; j < std::min(i + 4, nbBlockRows); ++j)
+            {
+                sofa::defaulttype::Mat<3,3,SReal> b;
+                for (int bi = 0; bi < 3; ++bi)
+                    for (int bj = 0; bj < 3; ++bj)
+                        b[bi][bj] = (SReal)helper::drand(1);
+                if (i == j) b = b + b.transposed();
+                *crs.wbloc(i, j, true) = b;
+                if (i != j) *crs.wbloc(j, i, true) = b.transposed();
+            }
+        }
+        crs.compress();
+        crsUpper.copyUpper(crs);
+
+        vec.resize(crs.colSize());
+        for (sofa::Index i = 0; i < vec.size(); ++i)
+            vec[i] = (SReal)helper::drand(1);
+
+        // generic product
+        reference.resize(crs.rowSize());
+        crs.addMul(reference, vec);
+    }
+};
+
+TEST_F(TestCRSBlockProducts, mul )
+{
+    crs.mul(result, vec);
+    ASSERT_LT(vectorMaxDiff(reference, result), 100*epsilon());
+}
+
+TEST_F(TestCRSBlockProducts, parallelMul )
+{
+    simulation::TaskScheduler* scheduler = simulation::TaskScheduler::create(simulation::DefaultTaskScheduler::name());
+    scheduler->init(4);
+    crs.parallelMul(result, vec, scheduler);
+    scheduler->stop();
+    ASSERT_LT(vectorMaxDiff(reference, result), 100*epsilon());
+}
+
+TEST_F(TestCRSBlockProducts, symmetricUpperMul )
+{
+    crs.symmetricUpperMul(result, vec);
+    EXPECT_LT(vectorMaxDiff(reference, result), 100*epsilon());
+
+    crsUpper.symmetricUpperMul(result, vec);
+    EXPECT_LT(vectorMaxDiff(reference, result), 100*epsilon());
+
+    simulation::TaskScheduler* scheduler = simulation::TaskScheduler::create(simulation::DefaultTaskScheduler::name());
+    scheduler->init(4);
+    crsUpper.symmetricUpperMul(result, vec, scheduler);
+    scheduler->stop();
+    EXPECT_LT(vectorMaxDiff(reference, result), 100*epsilon());
+}
+
+
 #if BENCHMARK_MATRIX_PRODUCT
 ///// product timing
 typedef TestSparseMatrices<Real,360,300,3,3> TsProductTimings;
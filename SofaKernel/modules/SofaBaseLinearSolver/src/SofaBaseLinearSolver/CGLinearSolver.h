@@ -44,6 +44,8 @@ public:
     Data<bool> f_warmStart; ///< Use previous solution as initial solution
     Data<bool> f_verbose; ///< Dump system state at each iteration
     Data<std::map < std::string, sofa::helper::vector<SReal> > > f_graph; ///< Graph of residuals at each iteration
+    Data<bool> d_parallelProduct; ///< Compute the matrix-vector products with the threads of the task scheduler (assembled sparse matrices only)
+    Data<bool> d_symmetricProduct; ///< Read only the upper triangle of the (symmetric) system matrix in the matrix-vector products (assembled sparse matrices only)
 
 protected:
 
@@ -55,6 +57,9 @@ protected:
     /// This method is separated from the rest to be able to use custom/optimized versions depending on the types of vectors.
     /// It computes: x += p*alpha, r -= q*alpha
     inline void cgstep_alpha(const core::ExecParams* params, Vector& x, Vector& r, Vector& p, Vector& q, SReal alpha);
+    /// This method is separated from the rest to be able to use custom/optimized versions depending on the types of matrices.
+    /// It computes: q = M*p
+    inline void cgstep_mul(Matrix& M, Vector& q, Vector& p);
 
     int timeStepCount;
     bool equilibriumReached;
@@ -22,6 +22,7 @@
 #pragma once
 #include <SofaBaseLinearSolver/CGLinearSolver.h>
 #include <sofa/simulation/MechanicalVisitor.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 #include <sofa/helper/AdvancedTimer.h>
 #include <sofa/helper/ScopedAdvancedTimer.h>
@@ -39,6 +40,8 @@ CGLinearSolver<TMatrix,TVector>::CGLinearSolver()
     , f_warmStart( initData(&f_warmStart,false,"warmStart","Use previous solution as initial solution") )
     , f_verbose( initData(&f_verbose,false,"verbose","Dump system state at each iteration") )
     , f_graph( initData(&f_graph,"graph","Graph of residuals at each iteration") )
+    , d_parallelProduct( initData(&d_parallelProduct,false,"parallelProduct","Compute the matrix-vector products with the threads of the task scheduler (assembled sparse matrices only)") )
+    , d_symmetricProduct( initData(&d_symmetricProduct,false,"symmetricProduct","Read only the upper triangle of the (symmetric) system matrix in the matrix-vector products (assembled sparse matrices only)") )
 {
     f_graph.setWidget("graph");
     f_maxIter.setRequired(true);
@@ -96,6 +99,36 @@ void CGLinearSolver<TMatrix,TVector>::setSystemMBKMatrix(const sofa::core::Mecha
     Inherit::setSystemMBKMatrix(mparams);
 }
 
+/// Generic matrix-vector product
+template<class Matrix, class Vector>
+inline void cgMatrixVectorProduct(Matrix& M, Vector& q, Vector& p, simulation::TaskScheduler* /*scheduler*/, bool /*symmetric*/)
+{
+    q = M*p;
+}
+
+/// Assembled sparse matrices use block kernels, optionally multithreaded and restricted to the upper triangle
+template<typename TBloc, typename TVecBloc, typename TVecIndex, typename Real>
+inline void cgMatrixVectorProduct(CompressedRowSparseMatrix<TBloc,TVecBloc,TVecIndex>& M, FullVector<Real>& q, FullVector<Real>& p, simulation::TaskScheduler* scheduler, bool symmetric)
+{
+    typedef CompressedRowSparseMatrix<TBloc,TVecBloc,TVecIndex> Matrix;
+    if constexpr ((int)Matrix::NL == (int)Matrix::NC)
+    {
+        if (symmetric)
+        {
+            M.symmetricUpperMul(q, p, scheduler);
+            return;
+        }
+    }
+    M.parallelMul(q, p, scheduler);
+}
+
+template<class TMatrix, class TVector>
+inline void CGLinearSolver<TMatrix,TVector>::cgstep_mul(Matrix& M, Vector& q, Vector& p)
+{
+    simulation::TaskScheduler* scheduler = d_parallelProduct.getValue() ? simulation::TaskScheduler::getInstance() : nullptr;
+    cgMatrixVectorProduct(M, q, p, scheduler, d_symmetricProduct.getValue());
+}
+
 /// Solve Mx=b
 template<class TMatrix, class TVector>
 void CGLinearSolver<TMatrix,TVector>::solve(Matrix& M, Vector& x, Vector& b)
@@ -124,7 +157,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& M, Vector& x, Vector& b)
     /// Compute the initial residual r
     if( f_warmStart.getValue() )
     {
-        r = M * x;
+        cgstep_mul(M, r, x);
         r.eq( b, r, -1.0 );   // initial residual r = b - Ax;
     }
     else
@@ -228,7 +261,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& M, Vector& x, Vector& b)
             }
 
             /// Compute the matrix-vector product : M p
-            q = M*p;
+            cgstep_mul(M, q, p);
 
             if( verbose )
             {
@@ -312,7 +345,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& M, Vector& x, Vector& b)
         if( timeStepCount==0 )
         {
             p = r;
-            q = M*p;
+            cgstep_mul(M, q, p);
             double den = p.dot(q);
 
             if(den != 0.0)
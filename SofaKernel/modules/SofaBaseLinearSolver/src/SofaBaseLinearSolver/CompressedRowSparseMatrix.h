@@ -29,6 +29,7 @@
 #include <sofa/helper/vector.h>
 #include <sofa/helper/rmath.h>
 #include <sofa/defaulttype/typeinfo/TypeInfo_Mat.h>
+#include <sofa/simulation/ParallelForEach.h>
 
 namespace sofa::component::linearsolver
 {
@@ -1581,6 +1582,232 @@ public:
     /// @}
 
 
+    /// @name products on FullVector using block kernels, optionally split among the threads of a task scheduler
+    /// @{
+
+    /// equal result = this * v
+    template< typename Real2 >
+    void mul( FullVector<Real2>& res, const FullVector<Real2>& v ) const
+    {
+        parallelMul(res, v, nullptr);
+    }
+
+    /// equal result = this * v, the block rows being split in ranges of about the same number of blocks,
+    /// processed by the threads of the scheduler (sequentially if the scheduler is null)
+    template< typename Real2 >
+    void parallelMul( FullVector<Real2>& res, const FullVector<Real2>& v, simulation::TaskScheduler* scheduler ) const
+    {
+        assert( v.size()%bColSize() == 0 ); // v.size() must be a multiple of block size.
+
+        ((Matrix*)this)->compress();
+        res.resize(rowSize());
+
+        const Index nbRanges = getNbProductRanges(scheduler);
+        const helper::vector<Index> ranges = balancedRowRanges(nbRanges);
+        Real2* r = res.ptr();
+        const Real2* x = v.ptr();
+        simulation::parallelForEach(scheduler, Index(0), nbRanges, [&](Index c)
+        {
+            mulRows(r, x, ranges[c], ranges[c+1]);
+        });
+    }
+
+    /// equal result = this * v for a symmetric matrix, reading only the values on and above the diagonal
+    /// (including inside the diagonal blocks). The lower triangle may thus be omitted from the storage
+    /// (see copyUpper) to halve the memory traffic.
+    /// With a scheduler, each range of block rows accumulates its transposed contributions in its own buffer,
+    /// the buffers being summed afterwards.
+    template< typename Real2 >
+    void symmetricUpperMul( FullVector<Real2>& res, const FullVector<Real2>& v, simulation::TaskScheduler* scheduler = nullptr ) const
+    {
+        static_assert(NL == NC, "the symmetric product requires square blocks");
+        assert( v.size()%bColSize() == 0 ); // v.size() must be a multiple of block size.
+
+        ((Matrix*)this)->compress();
+        res.resize(rowSize());
+
+        Real2* r = res.ptr();
+        const Real2* x = v.ptr();
+        const Index nbRanges = scheduler ? std::min<Index>((Index)scheduler->getThreadCount(), (Index)rowIndex.size()) : 1;
+        if (nbRanges <= 1)
+        {
+            mulUpperRows(r, r, x, 0, (Index)rowIndex.size());
+            return;
+        }
+
+        const helper::vector<Index> ranges = balancedRowRanges(nbRanges);
+        const Index n = rowSize();
+        std::vector<Real2> transposed((std::size_t)nbRanges * n);
+        simulation::parallelForEach(scheduler, Index(0), nbRanges, [&](Index c)
+        {
+            // transposed contributions only reach the rows below the first row of the range
+            Real2* t = transposed.data() + (std::size_t)c * n;
+            const Index first = (ranges[c] < ranges[c+1]) ? (Index)rowIndex[ranges[c]] * NL : n;
+            std::fill(t + first, t + n, Real2());
+            mulUpperRows(r, t, x, ranges[c], ranges[c+1]);
+        });
+
+        simulation::parallelForEachRange(scheduler, Index(0), n, [&](Index begin, Index end)
+        {
+            for (Index c = 0; c < nbRanges; ++c)
+            {
+                const Index first = (ranges[c] < ranges[c+1]) ? (Index)rowIndex[ranges[c]] * NL : n;
+                const Real2* t = transposed.data() + (std::size_t)c * n;
+                for (Index i = std::max(begin, first); i < end; ++i)
+                    r[i] += t[i];
+            }
+        }, Index(1024));
+    }
+
+    /// @}
+
+protected:
+
+    /// r += b * v for a single block. The 3x3 case is unrolled so that the whole block product stays in registers
+    template< typename Real2 >
+    static void blocAddMul( const Bloc& b, const Real2* v, Real2* r )
+    {
+        if constexpr (NL == 3 && NC == 3)
+        {
+            const Real2 v0 = v[0], v1 = v[1], v2 = v[2];
+            r[0] += traits::v(b,0,0) * v0 + traits::v(b,0,1) * v1 + traits::v(b,0,2) * v2;
+            r[1] += traits::v(b,1,0) * v0 + traits::v(b,1,1) * v1 + traits::v(b,1,2) * v2;
+            r[2] += traits::v(b,2,0) * v0 + traits::v(b,2,1) * v1 + traits::v(b,2,2) * v2;
+        }
+        else
+        {
+            for (Index bi = 0; bi < NL; ++bi)
+                for (Index bj = 0; bj < NC; ++bj)
+                    r[bi] += traits::v(b, bi, bj) * v[bj];
+        }
+    }
+
+    /// r += b^T * v for a single block
+    template< typename Real2 >
+    static void blocAddMulTranspose( const Bloc& b, const Real2* v, Real2* r )
+    {
+        if constexpr (NL == 3 && NC == 3)
+        {
+            const Real2 v0 = v[0], v1 = v[1], v2 = v[2];
+            r[0] += traits::v(b,0,0) * v0 + traits::v(b,1,0) * v1 + traits::v(b,2,0) * v2;
+            r[1] += traits::v(b,0,1) * v0 + traits::v(b,1,1) * v1 + traits::v(b,2,1) * v2;
+            r[2] += traits::v(b,0,2) * v0 + traits::v(b,1,2) * v1 + traits::v(b,2,2) * v2;
+        }
+        else
+        {
+            for (Index bi = 0; bi < NL; ++bi)
+                for (Index bj = 0; bj < NC; ++bj)
+                    r[bj] += traits::v(b, bi, bj) * v[bi];
+        }
+    }
+
+    /// r += b * v for a diagonal block of a symmetric matrix, using only its upper triangle
+    template< typename Real2 >
+    static void blocAddMulSymmetricUpper( const Bloc& b, const Real2* v, Real2* r )
+    {
+        if constexpr (NL == 3 && NC == 3)
+        {
+            const Real2 v0 = v[0], v1 = v[1], v2 = v[2];
+            const Real2 b01 = traits::v(b,0,1), b02 = traits::v(b,0,2), b12 = traits::v(b,1,2);
+            r[0] += traits::v(b,0,0) * v0 + b01 * v1 + b02 * v2;
+            r[1] += b01 * v0 + traits::v(b,1,1) * v1 + b12 * v2;
+            r[2] += b02 * v0 + b12 * v1 + traits::v(b,2,2) * v2;
+        }
+        else
+        {
+            for (Index bi = 0; bi < NL; ++bi)
+            {
+                r[bi] += traits::v(b, bi, bi) * v[bi];
+                for (Index bj = bi + 1; bj < NC; ++bj)
+                {
+                    r[bi] += traits::v(b, bi, bj) * v[bj];
+                    r[bj] += traits::v(b, bi, bj) * v[bi];
+                }
+            }
+        }
+    }
+
+    /// res = this * v on the non-empty block rows [xiBegin,xiEnd)
+    template< typename Real2 >
+    void mulRows( Real2* res, const Real2* v, Index xiBegin, Index xiEnd ) const
+    {
+        for (Index xi = xiBegin; xi < xiEnd; ++xi)
+        {
+            Real2 r[NL] = {};
+            for (Index xj = rowBegin[xi]; xj < (Index)rowBegin[xi+1]; ++xj)
+                blocAddMul(colsValue[xj], v + (Index)colsIndex[xj] * NC, r);
+
+            Real2* out = res + (Index)rowIndex[xi] * NL;
+            for (Index bi = 0; bi < NL; ++bi)
+                out[bi] = r[bi];
+        }
+    }
+
+    /// Symmetric product restricted to the blocks on and above the diagonal of the block rows [xiBegin,xiEnd).
+    /// The direct contributions are added to res, the transposed ones to resT (which may be res itself).
+    template< typename Real2 >
+    void mulUpperRows( Real2* res, Real2* resT, const Real2* v, Index xiBegin, Index xiEnd ) const
+    {
+        for (Index xi = xiBegin; xi < xiEnd; ++xi)
+        {
+            const Index i = rowIndex[xi];
+            const Real2* vi = v + i * NL;
+            Real2 r[NL] = {};
+
+            // skip the lower triangle, if it is stored
+            const auto rowEnd = colsIndex.begin() + rowBegin[xi+1];
+            auto it = std::lower_bound(colsIndex.begin() + rowBegin[xi], rowEnd, (typename VecIndex::value_type)i);
+            for (Index xj = (Index)(it - colsIndex.begin()); xj < (Index)rowBegin[xi+1]; ++xj)
+            {
+                const Index j = colsIndex[xj];
+                const Bloc& b = colsValue[xj];
+                if (j == i)
+                {
+                    blocAddMulSymmetricUpper(b, vi, r);
+                }
+                else
+                {
+                    blocAddMul(b, v + j * NC, r);
+                    blocAddMulTranspose(b, vi, resT + j * NC);
+                }
+            }
+
+            Real2* out = res + i * NL;
+            for (Index bi = 0; bi < NL; ++bi)
+                out[bi] += r[bi];
+        }
+    }
+
+    /// Number of ranges of block rows used by the products: a few per thread to let the scheduler balance the work
+    Index getNbProductRanges( simulation::TaskScheduler* scheduler ) const
+    {
+        const Index nbRows = (Index)rowIndex.size();
+        if (!scheduler || nbRows < 2 * productGrainSize)
+            return nbRows > 0 ? 1 : 0;
+        return std::min<Index>(4 * (Index)scheduler->getThreadCount(), nbRows / productGrainSize);
+    }
+
+    /// Split the non-empty block rows in nbRanges contiguous ranges holding about the same number of blocks
+    helper::vector<Index> balancedRowRanges( Index nbRanges ) const
+    {
+        helper::vector<Index> ranges(nbRanges + 1);
+        const Index nbRows = (Index)rowIndex.size();
+        const std::size_t nbBlocs = nbRows > 0 ? rowBegin[nbRows] : 0;
+        for (Index c = 0; c < nbRanges; ++c)
+        {
+            const std::size_t target = nbBlocs * c / nbRanges;
+            ranges[c] = (Index)(std::lower_bound(rowBegin.begin(), rowBegin.begin() + nbRows, target) - rowBegin.begin());
+        }
+        ranges[nbRanges] = nbRows;
+        return ranges;
+    }
+
+    /// Minimum number of block rows per range in the multithreaded products
+    static constexpr Index productGrainSize = 64;
+
+public:
+
+
     // methods for MatrixExpr support
 
     template<class M2>
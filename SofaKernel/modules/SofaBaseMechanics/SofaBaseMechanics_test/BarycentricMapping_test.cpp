@@ -51,6 +51,11 @@ using sofa::component::container::MechanicalObject ;
 
 #include <sofa/simulation/Node.h>
 
+#include <sofa/testing/AllocationCounter.h>
+using sofa::testing::ScopedHeapAllocationCounter ;
+
+SOFA_TESTING_COUNT_HEAP_ALLOCATIONS()
+
 using sofa::defaulttype::Vec3dTypes;
 
 template <class In, class Out>
@@ -120,6 +125,27 @@ struct BarycentricMapperTriangleSetTopologyTest :  public Test, public Barycentr
         EXPECT_EQ(d_map.getValue().size(),2);
     }
 
+    void applyJTConstraintDoesNotAllocate_test()
+    {
+        init(m_out,m_in);
+
+        typename Out::MatrixDeriv in;
+        for (unsigned int i=0; i<m_out.size(); i++)
+        {
+            typename Out::MatrixDeriv::RowIterator row = in.writeLine(i);
+            row.addCol(i, typename Out::Deriv(1.0, 2.0, 3.0));
+        }
+
+        // the first product creates the lines of the result
+        typename In::MatrixDeriv out;
+        this->applyJT(out, in);
+
+        // the next ones only accumulate in the existing entries
+        ScopedHeapAllocationCounter counter;
+        this->applyJT(out, in);
+        EXPECT_EQ(counter.getCount(), 0u);
+    }
+
     void initHashing_test()
     {
         Real min =(m_in[0]-m_in[1]).norm();
@@ -140,6 +166,11 @@ TEST_F(BarycentricMapperTriangleSetTopologyTest_d, init)
     EXPECT_NO_THROW(init_test());
 }
 
+TEST_F(BarycentricMapperTriangleSetTopologyTest_d, applyJTConstraintDoesNotAllocate)
+{
+    applyJTConstraintDoesNotAllocate_test();
+}
+
 TEST_F(BarycentricMapperTriangleSetTopologyTest_d, initHashing)
 {
     initHashing_test();
@@ -62,9 +62,9 @@ protected:
 
     ~BarycentricMapperEdgeSetTopology() override {}
 
-    virtual helper::vector<Edge> getElements() override;
-    virtual helper::vector<SReal> getBaryCoef(const Real* f) override;
-    helper::vector<SReal> getBaryCoef(const Real fx);
+    virtual const helper::vector<Edge>& getElements() override;
+    virtual helper::ScratchVector<SReal> getBaryCoef(const Real* f) override;
+    helper::ScratchVector<SReal> getBaryCoef(const Real fx);
     void computeBase(Mat3x3d& base, const typename In::VecCoord& in, const Edge& element) override;
     void computeCenter(Vector3& center, const typename In::VecCoord& in, const Edge& element) override;
     void computeDistance(double& d, const Vector3& v) override;
@@ -58,21 +58,21 @@ typename BarycentricMapperEdgeSetTopology<In, Out>::Index BarycentricMapperEdgeS
 }
 
 template <class In, class Out>
-helper::vector<Edge> BarycentricMapperEdgeSetTopology<In,Out>::getElements()
+const helper::vector<Edge>& BarycentricMapperEdgeSetTopology<In,Out>::getElements()
 {
     return this->m_fromTopology->getEdges();
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperEdgeSetTopology<In,Out>::getBaryCoef(const Real* f)
+helper::ScratchVector<SReal> BarycentricMapperEdgeSetTopology<In,Out>::getBaryCoef(const Real* f)
 {
     return getBaryCoef(f[0]);
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperEdgeSetTopology<In,Out>::getBaryCoef(const Real fx)
+helper::ScratchVector<SReal> BarycentricMapperEdgeSetTopology<In,Out>::getBaryCoef(const Real fx)
 {
-    helper::vector<SReal> edgeCoef{1-fx,fx};
+    helper::ScratchVector<SReal> edgeCoef{1-fx,fx};
     return edgeCoef;
 }
 
@@ -50,9 +50,9 @@ public:
     typedef typename Inherit1::Real Real;
 
     ~BarycentricMapperHexahedronSetTopology() override ;
-    virtual helper::vector<Hexahedron> getElements() override;
-    virtual helper::vector<SReal> getBaryCoef(const Real* f) override;
-    helper::vector<SReal> getBaryCoef(const Real fx, const Real fy, const Real fz);
+    virtual const helper::vector<Hexahedron>& getElements() override;
+    virtual helper::ScratchVector<SReal> getBaryCoef(const Real* f) override;
+    helper::ScratchVector<SReal> getBaryCoef(const Real fx, const Real fy, const Real fz);
     void computeBase(Mat3x3d& base, const typename In::VecCoord& in, const Hexahedron& element) override;
     void computeCenter(Vector3& center, const typename In::VecCoord& in, const Hexahedron& element) override;
     void computeDistance(double& d, const Vector3& v) override;
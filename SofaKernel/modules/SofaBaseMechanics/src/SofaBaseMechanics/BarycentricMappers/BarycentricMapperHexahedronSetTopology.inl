@@ -93,23 +93,23 @@ BarycentricMapperHexahedronSetTopology<In,Out>::setPointInCube ( const Index poi
 
 
 template <class In, class Out>
-helper::vector<Hexahedron> BarycentricMapperHexahedronSetTopology<In,Out>::getElements()
+const helper::vector<Hexahedron>& BarycentricMapperHexahedronSetTopology<In,Out>::getElements()
 {
     return this->m_fromTopology->getHexahedra();
 }
 
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperHexahedronSetTopology<In,Out>::getBaryCoef(const Real* f)
+helper::ScratchVector<SReal> BarycentricMapperHexahedronSetTopology<In,Out>::getBaryCoef(const Real* f)
 {
     return getBaryCoef(f[0],f[1],f[2]);
 }
 
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperHexahedronSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy, const Real fz)
+helper::ScratchVector<SReal> BarycentricMapperHexahedronSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy, const Real fz)
 {
-    helper::vector<SReal> hexahedronCoef{(1-fx)*(1-fy)*(1-fz),
+    helper::ScratchVector<SReal> hexahedronCoef{(1-fx)*(1-fy)*(1-fz),
                 (fx)*(1-fy)*(1-fz),
                 (fx)*(fy)*(1 - fz),
                 (1 - fx)*(fy)*(1 - fz),
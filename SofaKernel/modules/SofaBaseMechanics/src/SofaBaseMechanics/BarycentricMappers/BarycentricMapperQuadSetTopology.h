@@ -54,9 +54,9 @@ protected:
     BarycentricMapperQuadSetTopology(topology::QuadSetTopologyContainer* fromTopology,
                                      topology::PointSetTopologyContainer* toTopology);
 
-    virtual helper::vector<Quad> getElements() override;
-    virtual helper::vector<SReal> getBaryCoef(const Real* f) override;
-    helper::vector<SReal> getBaryCoef(const Real fx, const Real fy);
+    virtual const helper::vector<Quad>& getElements() override;
+    virtual helper::ScratchVector<SReal> getBaryCoef(const Real* f) override;
+    helper::ScratchVector<SReal> getBaryCoef(const Real fx, const Real fy);
     void computeBase(Mat3x3d& base, const typename In::VecCoord& in, const Quad& element) override;
     void computeCenter(Vector3& center, const typename In::VecCoord& in, const Quad& element) override;
     void computeDistance(double& d, const Vector3& v) override;
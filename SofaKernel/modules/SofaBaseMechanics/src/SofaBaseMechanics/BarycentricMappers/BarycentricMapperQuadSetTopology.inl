@@ -76,21 +76,21 @@ BarycentricMapperQuadSetTopology<In,Out>::createPointInQuad ( const typename Out
 }
 
 template <class In, class Out>
-helper::vector<Quad> BarycentricMapperQuadSetTopology<In,Out>::getElements()
+const helper::vector<Quad>& BarycentricMapperQuadSetTopology<In,Out>::getElements()
 {
     return this->m_fromTopology->getQuads();
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperQuadSetTopology<In,Out>::getBaryCoef(const Real* f)
+helper::ScratchVector<SReal> BarycentricMapperQuadSetTopology<In,Out>::getBaryCoef(const Real* f)
 {
     return getBaryCoef(f[0],f[1]);
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperQuadSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy)
+helper::ScratchVector<SReal> BarycentricMapperQuadSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy)
 {
-    helper::vector<SReal> quadCoef{(1-fx)*(1-fy),
+    helper::ScratchVector<SReal> quadCoef{(1-fx)*(1-fy),
                 (fx)*(1-fy),
                 (fx)*(fy),
                 (1 - fx)*(fy)};
@@ -54,9 +54,9 @@ protected:
                                             topology::PointSetTopologyContainer* toTopology);
     ~BarycentricMapperTetrahedronSetTopology() override {}
 
-    virtual helper::vector<Tetrahedron> getElements() override;
-    virtual helper::vector<SReal> getBaryCoef(const Real* f) override;
-    helper::vector<SReal> getBaryCoef(const Real fx, const Real fy, const Real fz);
+    virtual const helper::vector<Tetrahedron>& getElements() override;
+    virtual helper::ScratchVector<SReal> getBaryCoef(const Real* f) override;
+    helper::ScratchVector<SReal> getBaryCoef(const Real fx, const Real fy, const Real fz);
     void computeBase(Mat3x3d& base, const typename In::VecCoord& in, const Tetrahedron& element) override;
     void computeCenter(Vector3& center, const typename In::VecCoord& in, const Tetrahedron& element) override;
     void computeDistance(double& d, const Vector3& v) override;
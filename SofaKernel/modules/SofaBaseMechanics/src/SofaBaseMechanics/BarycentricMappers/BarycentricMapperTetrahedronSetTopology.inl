@@ -49,21 +49,21 @@ BarycentricMapperTetrahedronSetTopology<In,Out>::addPointInTetra ( const Index t
 }
 
 template <class In, class Out>
-helper::vector<Tetrahedron> BarycentricMapperTetrahedronSetTopology<In,Out>::getElements()
+const helper::vector<Tetrahedron>& BarycentricMapperTetrahedronSetTopology<In,Out>::getElements()
 {
     return this->m_fromTopology->getTetrahedra();
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperTetrahedronSetTopology<In,Out>::getBaryCoef(const Real* f)
+helper::ScratchVector<SReal> BarycentricMapperTetrahedronSetTopology<In,Out>::getBaryCoef(const Real* f)
 {
     return getBaryCoef(f[0],f[1],f[2]);
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperTetrahedronSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy, const Real fz)
+helper::ScratchVector<SReal> BarycentricMapperTetrahedronSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy, const Real fz)
 {
-    helper::vector<SReal> tetrahedronCoef{(1-fx-fy-fz),fx,fy,fz};
+    helper::ScratchVector<SReal> tetrahedronCoef{(1-fx-fy-fz),fx,fy,fz};
     return tetrahedronCoef;
 }
 
@@ -23,6 +23,7 @@
 #include <SofaBaseMechanics/BarycentricMappers/TopologyBarycentricMapper.h>
 
 #include <SofaBaseTopology/TopologyData.inl>
+#include <sofa/helper/ScratchArena.h>
 #include <unordered_map>
 
 namespace sofa::component::mapping::_barycentricmappertopologycontainer_
@@ -149,8 +150,8 @@ protected:
 
     ~BarycentricMapperTopologyContainer() override {}
 
-    virtual helper::vector<Element> getElements()=0;
-    virtual helper::vector<SReal> getBaryCoef(const Real* f)=0;
+    virtual const helper::vector<Element>& getElements()=0;
+    virtual helper::ScratchVector<SReal> getBaryCoef(const Real* f)=0;
     virtual void computeBase(Mat3x3d& base, const typename In::VecCoord& in, const Element& element)=0;
     virtual void computeCenter(Vector3& center, const typename In::VecCoord& in, const Element& element)=0;
     virtual void addPointInElement(const Index elementIndex, const SReal* baryCoords)=0;
@@ -240,6 +240,7 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT
 {
     typename Out::MatrixDeriv::RowConstIterator rowItEnd = in.end();
     const helper::vector< Element >& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
 
     for (typename Out::MatrixDeriv::RowConstIterator rowIt = in.begin(); rowIt != rowItEnd; ++rowIt)
     {
@@ -257,7 +258,8 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT
 
                 const Element& element = elements[d_map.getValue()[indexIn].in_index];
 
-                helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[indexIn].baryCoords);
+                helper::ScratchArena::Scope scratch(arena);
+                helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[indexIn].baryCoords);
                 for (unsigned int j=0; j<element.size(); j++)
                     o.addCol(element[j], data*baryCoef[j]);
             }
@@ -280,6 +282,7 @@ const defaulttype::BaseMatrix* BarycentricMapperTopologyContainer<In,Out,Mapping
         m_matrixJ->clear();
 
     const helper::vector<Element>& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
 
     for( size_t outId=0 ; outId<this->maskTo->size() ; ++outId)
     {
@@ -287,7 +290,8 @@ const defaulttype::BaseMatrix* BarycentricMapperTopologyContainer<In,Out,Mapping
 
         const Element& element = elements[d_map.getValue()[outId].in_index];
 
-        helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[outId].baryCoords);
+        helper::ScratchArena::Scope scratch(arena);
+        helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[outId].baryCoords);
         for (unsigned int j=0; j<element.size(); j++)
             this->addMatrixContrib(m_matrixJ, int(outId), element[j], baryCoef[j]);
     }
@@ -302,6 +306,7 @@ template <class In, class Out, class MappingDataType, class Element>
 void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT ( typename In::VecDeriv& out, const typename Out::VecDeriv& in )
 {
     const helper::vector<Element>& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
 
     ForceMask& mask = *this->maskFrom;
     for( size_t i=0 ; i<this->maskTo->size() ; ++i)
@@ -312,7 +317,8 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT
         const Element& element = elements[index];
 
         const typename Out::DPos inPos = Out::getDPos(in[i]);
-        helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
+        helper::ScratchArena::Scope scratch(arena);
+        helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
         for (unsigned int j=0; j<element.size(); j++)
         {
             out[element[j]] += inPos * baryCoef[j];
@@ -327,6 +333,7 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJ
     out.resize( d_map.getValue().size() );
 
     const helper::vector<Element>& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
 
     for( size_t i=0 ; i<this->maskTo->size() ; ++i)
     {
@@ -335,7 +342,8 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJ
         Index index = d_map.getValue()[i].in_index;
         const Element& element = elements[index];
 
-        helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
+        helper::ScratchArena::Scope scratch(arena);
+        helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
         InDeriv inPos{0.,0.,0.};
         for (unsigned int j=0; j<element.size(); j++)
             inPos += in[element[j]] * baryCoef[j];
@@ -365,12 +373,14 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::apply (
     out.resize( d_map.getValue().size() );
 
     const helper::vector<Element>& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
     for ( unsigned int i=0; i<d_map.getValue().size(); i++ )
     {
         Index index = d_map.getValue()[i].in_index;
         const Element& element = elements[index];
 
-        helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
+        helper::ScratchArena::Scope scratch(arena);
+        helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
         InDeriv inPos{0.,0.,0.};
         for (unsigned int j=0; j<element.size(); j++)
             inPos += in[element[j]] * baryCoef[j];
@@ -387,6 +397,7 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::draw  (
 {
     // Draw line between mapped node (out) and nodes of nearest element (in)
     const helper::vector<Element>& elements = getElements();
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
 
     std::vector< Vector3 > points;
     {
@@ -394,7 +405,8 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::draw  (
         {
             Index index = d_map.getValue()[i].in_index;
             const Element& element = elements[index];
-            helper::vector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
+            helper::ScratchArena::Scope scratch(arena);
+            helper::ScratchVector<SReal> baryCoef = getBaryCoef(d_map.getValue()[i].baryCoords);
             for ( unsigned int j=0; j<element.size(); j++ )
             {
                 if ( baryCoef[j]<=-0.0001 || baryCoef[j]>=0.0001 )
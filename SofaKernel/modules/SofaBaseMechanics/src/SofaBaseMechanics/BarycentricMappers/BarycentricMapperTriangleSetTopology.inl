@@ -76,21 +76,21 @@ BarycentricMapperTriangleSetTopology<In,Out>::createPointInTriangle ( const type
 
 
 template <class In, class Out>
-helper::vector<Triangle> BarycentricMapperTriangleSetTopology<In,Out>::getElements()
+const helper::vector<Triangle>& BarycentricMapperTriangleSetTopology<In,Out>::getElements()
 {
     return this->m_fromTopology->getTriangles();
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperTriangleSetTopology<In,Out>::getBaryCoef(const Real* f)
+helper::ScratchVector<SReal> BarycentricMapperTriangleSetTopology<In,Out>::getBaryCoef(const Real* f)
 {
     return getBaryCoef(f[0],f[1]);
 }
 
 template <class In, class Out>
-helper::vector<SReal> BarycentricMapperTriangleSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy)
+helper::ScratchVector<SReal> BarycentricMapperTriangleSetTopology<In,Out>::getBaryCoef(const Real fx, const Real fy)
 {
-    helper::vector<SReal> triangleCoef{1-fx-fy, fx, fy};
+    helper::ScratchVector<SReal> triangleCoef{1-fx-fy, fx, fy};
     return triangleCoef;
 }
 
@@ -28,6 +28,9 @@ using sofa::helper::testing::BaseTest;
 #include <sofa/core/objectmodel/BaseData.h>
 using sofa::core::objectmodel::BaseData;
 
+#include <sofa/core/objectmodel/DataMemoryReport.h>
+using sofa::core::objectmodel::DataMemoryReport;
+
 class MyData : public BaseData
 {
 public:
@@ -63,3 +66,50 @@ TEST_F(BaseData_test, setGetName)
     m_object.myData.setName("data1");
     ASSERT_EQ(m_object.myData.getName(), "data1");
 }
+
+class MyObjectWithInitData : public BaseObject
+{
+public:
+    SOFA_CLASS(MyObjectWithInitData, BaseObject);
+    sofa::core::objectmodel::Data<int> d_value;
+    MyObjectWithInitData() :
+        d_value(initData(&d_value, 0, "value", "a value shared by all the instances")) {}
+};
+
+TEST_F(BaseData_test, descriptorIsSharedBetweenInstances)
+{
+    MyObjectWithInitData a;
+    MyObjectWithInitData b;
+    EXPECT_EQ(a.d_value.getDescriptor(), b.d_value.getDescriptor());
+    EXPECT_EQ(a.d_value.getName(), "value");
+    EXPECT_EQ(a.d_value.getHelp(), "a value shared by all the instances");
+}
+
+TEST_F(BaseData_test, descriptorIsReplacedWhenMetadataChanges)
+{
+    MyObjectWithInitData a;
+    MyObjectWithInitData b;
+    const auto* shared = a.d_value.getDescriptor();
+
+    a.d_value.setGroup("Visualization");
+    EXPECT_NE(a.d_value.getDescriptor(), shared);
+    EXPECT_EQ(b.d_value.getDescriptor(), shared);
+    EXPECT_EQ(a.d_value.getGroup(), "Visualization");
+    EXPECT_EQ(b.d_value.getGroup(), "");
+
+    b.d_value.setGroup("Visualization");
+    EXPECT_EQ(a.d_value.getDescriptor(), b.d_value.getDescriptor());
+}
+
+TEST_F(BaseData_test, memoryReport)
+{
+    MyObjectWithInitData a;
+    DataMemoryReport report;
+    report.addComponent(&a);
+
+    EXPECT_EQ(report.nbComponents, 1u);
+    EXPECT_EQ(report.nbData, a.getDataFields().size());
+    EXPECT_EQ(report.dataBytes, report.nbData * sizeof(BaseData));
+    EXPECT_GT(report.unsharedMetadataBytes, 0u);
+    EXPECT_GT(DataMemoryReport::getNbDescriptors(), 0u);
+}
@@ -41,9 +41,9 @@ BaseData::BaseData(const char* h, DataFlags dataflags) : BaseData(sofa::helper::
 }
 
 BaseData::BaseData(const std::string& h, DataFlags dataflags)
-    : help(h), ownerClass(""), group(""), widget("")
+    : m_descriptor(DataDescriptor::get({}, h))
     , m_counter(), m_isSet(), m_dataFlags(dataflags)
-    , m_owner(nullptr), m_name("")
+    , m_owner(nullptr)
     , parentData(*this)
 {
     m_counter = 0;
@@ -57,8 +57,8 @@ BaseData::BaseData( const char* helpMsg, bool isDisplayed, bool isReadOnly) : Ba
 
 
 BaseData::BaseData( const std::string& h, bool isDisplayed, bool isReadOnly)
-    : help(h), ownerClass(""), group(""), widget("")
-    , m_counter(), m_isSet(), m_dataFlags(FLAG_DEFAULT), m_owner(nullptr), m_name("")
+    : m_descriptor(DataDescriptor::get({}, h))
+    , m_counter(), m_isSet(), m_dataFlags(FLAG_DEFAULT), m_owner(nullptr)
     , parentData(*this)
 {
     m_counter = 0;
@@ -69,9 +69,9 @@ BaseData::BaseData( const std::string& h, bool isDisplayed, bool isReadOnly)
 }
 
 BaseData::BaseData( const BaseInitData& init)
-    : help(init.helpMsg), ownerClass(init.ownerClass), group(init.group), widget(init.widget)
+    : m_descriptor(DataDescriptor::get(init.name, init.helpMsg, init.ownerClass, init.group, init.widget))
     , m_counter(), m_isSet(), m_dataFlags(init.dataFlags)
-    , m_owner(init.owner), m_name(init.name)
+    , m_owner(init.owner)
     , parentData(*this)
 {
     m_counter = 0;
@@ -88,7 +88,7 @@ BaseData::BaseData( const BaseInitData& init)
         sofa::helper::BackTrace::dump();
         exit( EXIT_FAILURE );
     }
-    if (m_owner) m_owner->addData(this, m_name);
+    if (m_owner) m_owner->addData(this, getName());
     setFlag(FLAG_PERSISTENT, false);
 }
 
@@ -171,7 +171,7 @@ void BaseData::update()
     {
 #ifdef SOFA_DDG_TRACE
         if (m_owner)
-            dmsg_warning(m_owner) << "Data " << m_name << ": update from parent " << parentBaseData->m_name;
+            dmsg_warning(m_owner) << "Data " << getName() << ": update from parent " << parentBaseData->getName();
 #endif
         updateValueFromLink(parent);
         // If the value is dirty clean it
@@ -26,6 +26,7 @@
 #include <sofa/defaulttype/DataTypeInfo.h>
 #include <sofa/core/objectmodel/DDGNode.h>
 #include <sofa/core/objectmodel/DataLink.h>
+#include <sofa/core/objectmodel/DataDescriptor.h>
 
 namespace sofa
 {
@@ -147,30 +148,33 @@ public:
     void endEditVoidPtr();
 
     /// Get a help message that describes this %Data.
-    const std::string& getHelp() const { return help; }
+    const std::string& getHelp() const { return m_descriptor->getHelp(); }
 
     /// Set the help message.
-    void setHelp(const std::string& val) { help = val; }
+    void setHelp(const std::string& val) { m_descriptor = m_descriptor->withHelp(val); }
 
     /// Get owner class
     SOFA_ATTRIBUTE_REMOVAL_OF_BASEDATA_OWNERCLASS_ACCESSOR("Replace getOwnerClass() by getOwner()->className")
-    const std::string& getOwnerClass() const { return ownerClass; }
+    const std::string& getOwnerClass() const { return m_descriptor->getOwnerClass(); }
 
     /// Set owner class
     SOFA_ATTRIBUTE_REMOVAL_OF_BASEDATA_OWNERCLASS_ACCESSOR("The function will be totally removed. The owner's class name being using getOwner()->className")
-    void setOwnerClass(const char* val) { ownerClass = val; }
+    void setOwnerClass(const char* val) { m_descriptor = m_descriptor->withOwnerClass(val ? val : ""); }
 
     /// Get group
-    const std::string& getGroup() const { return group; }
+    const std::string& getGroup() const { return m_descriptor->getGroup(); }
 
     /// Set group
-    void setGroup(const std::string& val) { group = val; }
+    void setGroup(const std::string& val) { m_descriptor = m_descriptor->withGroup(val); }
 
     /// Get widget
-    const std::string& getWidget() const { return widget; }
+    const std::string& getWidget() const { return m_descriptor->getWidget(); }
 
     /// Set widget
-    void setWidget(const char* val) { widget = val; }
+    void setWidget(const char* val) { m_descriptor = m_descriptor->withWidget(val ? val : ""); }
+
+    /// Get the metadata shared with the other instances of this %Data
+    const DataDescriptor* getDescriptor() const { return m_descriptor; }
 
     /// True if the counter of modification gives valid information.
     SOFA_ATTRIBUTE_DEPRECATED__TDATA_INTO_DATA("Data<> must have, by design, their counter valid.")
@@ -229,11 +233,11 @@ public:
     }
 
     /// Return the name of this %Data within the Base component
-    const std::string& getName() const { return m_name; }
+    const std::string& getName() const { return m_descriptor->getName(); }
     /// Set the name of this %Data.
     ///
     /// This method should not be called directly, the %Data registration methods in Base should be used instead.
-    void setName(const std::string& name) { m_name=name; }
+    void setName(const std::string& name) { m_descriptor = m_descriptor->withName(name); }
 
 
     /// @name Optimized edition and retrieval API (for multi-threading performances)
@@ -288,14 +292,8 @@ public:
     bool copyValueFrom(const BaseData* data);
     bool updateValueFromLink(const BaseData* data);
 
-    /// Help message
-    std::string help {""};
-    /// Owner class
-    std::string ownerClass {""} ;
-    /// group
-    std::string group {""};
-    /// widget
-    std::string widget {""};
+    /// Name, help message, group, widget and owner class, shared by all the instances of this %Data
+    const DataDescriptor* m_descriptor;
     /// Number of changes since creation
     int m_counter;
     /// True if this %Data is set, i.e. its value is different from the default value
@@ -304,8 +302,6 @@ public:
     DataFlags m_dataFlags;
     /// Return the Base component owning this %Data
     Base* m_owner {nullptr};
-    /// Data name within the Base component
-    std::string m_name;
 
     /// Parent Data
     DataLink<BaseData> parentData;
@@ -23,6 +23,7 @@
 
 #include <sofa/core/config.h>
 #include <sofa/core/fwd.h>
+#include <sofa/helper/SmallVector.h>
 #include <vector>
 
 namespace sofa::core::objectmodel
@@ -39,7 +40,8 @@ class DDGNode;
 class SOFA_CORE_API DDGNode
 {
 public:
-    typedef std::vector<DDGNode*> DDGLinkContainer;
+    /// Most of the nodes have at most one input and one output: they are stored without any heap allocation
+    typedef helper::SmallVector<DDGNode*, 1> DDGLinkContainer;
     typedef DDGLinkContainer::const_iterator DDGLinkIterator;
 
     /// Constructor
@@ -66,6 +68,9 @@ public:
     /// Get the list of outputs for this DDGNode
     const DDGLinkContainer& getOutputs();
 
+    /// Memory allocated on the heap by the lists of inputs and outputs, in bytes
+    std::size_t getLinksHeapMemory() const { return inputs.getHeapMemory() + outputs.getHeapMemory(); }
+
     /// Update this value
     virtual void update() = 0;
 
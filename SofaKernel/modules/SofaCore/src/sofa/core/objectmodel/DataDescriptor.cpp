@@ -0,0 +1,156 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/core/objectmodel/DataDescriptor.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace sofa::core::objectmodel
+{
+
+namespace
+{
+
+std::size_t hashFields(std::string_view name, std::string_view help, std::string_view ownerClass,
+                       std::string_view group, std::string_view widget)
+{
+    const std::hash<std::string_view> hasher;
+    std::size_t seed = 0;
+    for (const std::string_view& field : { name, help, ownerClass, group, widget })
+        seed ^= hasher(field) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+std::size_t stringHeapMemory(const std::string& s)
+{
+    // strings short enough to be stored in the object itself do not use the heap
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+struct DescriptorRegistry
+{
+    std::mutex mutex;
+    /// the deque does not move its elements, so that the pointers to the descriptors stay valid
+    std::deque<DataDescriptor> descriptors;
+    std::unordered_multimap<std::size_t, const DataDescriptor*> index;
+
+    const DataDescriptor* get(std::string_view name, std::string_view help, std::string_view ownerClass,
+                              std::string_view group, std::string_view widget)
+    {
+        const std::size_t hash = hashFields(name, help, ownerClass, group, widget);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto range = index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const DataDescriptor* d = it->second;
+            if (d->getName() == name && d->getHelp() == help && d->getOwnerClass() == ownerClass
+                    && d->getGroup() == group && d->getWidget() == widget)
+                return d;
+        }
+
+        const DataDescriptor* d = &descriptors.emplace_back(name, help, ownerClass, group, widget);
+        index.emplace(hash, d);
+        return d;
+    }
+};
+
+DescriptorRegistry& getRegistry()
+{
+    static DescriptorRegistry registry;
+    return registry;
+}
+
+} // anonymous namespace
+
+
+DataDescriptor::DataDescriptor(std::string_view name, std::string_view help, std::string_view ownerClass,
+                               std::string_view group, std::string_view widget)
+    : m_name(name), m_help(help), m_ownerClass(ownerClass), m_group(group), m_widget(widget)
+{
+}
+
+const DataDescriptor* DataDescriptor::get(std::string_view name, std::string_view help, std::string_view ownerClass,
+                                          std::string_view group, std::string_view widget)
+{
+    return getRegistry().get(name, help, ownerClass, group, widget);
+}
+
+const DataDescriptor* DataDescriptor::getEmpty()
+{
+    static const DataDescriptor* empty = get({}, {});
+    return empty;
+}
+
+const DataDescriptor* DataDescriptor::withName(std::string_view name) const
+{
+    return get(name, m_help, m_ownerClass, m_group, m_widget);
+}
+
+const DataDescriptor* DataDescriptor::withHelp(std::string_view help) const
+{
+    return get(m_name, help, m_ownerClass, m_group, m_widget);
+}
+
+const DataDescriptor* DataDescriptor::withOwnerClass(std::string_view ownerClass) const
+{
+    return get(m_name, m_help, ownerClass, m_group, m_widget);
+}
+
+const DataDescriptor* DataDescriptor::withGroup(std::string_view group) const
+{
+    return get(m_name, m_help, m_ownerClass, group, m_widget);
+}
+
+const DataDescriptor* DataDescriptor::withWidget(std::string_view widget) const
+{
+    return get(m_name, m_help, m_ownerClass, m_group, widget);
+}
+
+std::size_t DataDescriptor::getMemoryFootprint() const
+{
+    return sizeof(DataDescriptor) + stringHeapMemory(m_name) + stringHeapMemory(m_help)
+            + stringHeapMemory(m_ownerClass) + stringHeapMemory(m_group) + stringHeapMemory(m_widget);
+}
+
+std::size_t DataDescriptor::getNbDescriptors()
+{
+    DescriptorRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.descriptors.size();
+}
+
+std::size_t DataDescriptor::getRegistryMemoryFootprint()
+{
+    DescriptorRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::size_t memory = 0;
+    for (const DataDescriptor& d : registry.descriptors)
+        memory += d.getMemoryFootprint();
+    // entries of the index
+    memory += registry.index.size() * (sizeof(std::size_t) + 2 * sizeof(void*));
+    return memory;
+}
+
+} // namespace sofa::core::objectmodel
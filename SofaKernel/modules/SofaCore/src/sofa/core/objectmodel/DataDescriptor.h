@@ -0,0 +1,92 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/core/config.h>
+
+#include <string>
+#include <string_view>
+
+namespace sofa::core::objectmodel
+{
+
+/**
+ *  \brief Metadata of a Data (name, help message, group, widget, owner class), shared between all its instances.
+ *
+ *  These strings are the same for a given field in every instance of a component class,
+ *  so they are stored only once: the descriptors are interned in a global registry, and each
+ *  BaseData only holds a pointer to its descriptor. The descriptors are immutable, changing a
+ *  field of a Data (e.g. BaseData::setGroup) makes it point to another descriptor.
+ *
+ *  The descriptors are never destroyed, the pointers stay valid until the end of the program.
+ */
+class SOFA_CORE_API DataDescriptor
+{
+public:
+    /// Interned descriptor with the given fields
+    static const DataDescriptor* get(std::string_view name, std::string_view help,
+                                     std::string_view ownerClass = {}, std::string_view group = {},
+                                     std::string_view widget = {});
+
+    /// Descriptor with all the fields empty
+    static const DataDescriptor* getEmpty();
+
+    const std::string& getName() const { return m_name; }
+    const std::string& getHelp() const { return m_help; }
+    const std::string& getOwnerClass() const { return m_ownerClass; }
+    const std::string& getGroup() const { return m_group; }
+    const std::string& getWidget() const { return m_widget; }
+
+    /// @name Descriptor with a single field changed
+    /// @{
+    const DataDescriptor* withName(std::string_view name) const;
+    const DataDescriptor* withHelp(std::string_view help) const;
+    const DataDescriptor* withOwnerClass(std::string_view ownerClass) const;
+    const DataDescriptor* withGroup(std::string_view group) const;
+    const DataDescriptor* withWidget(std::string_view widget) const;
+    /// @}
+
+    /// Memory used by this descriptor, in bytes
+    std::size_t getMemoryFootprint() const;
+
+    /// Number of descriptors in the registry
+    static std::size_t getNbDescriptors();
+
+    /// Memory used by all the descriptors of the registry, in bytes
+    static std::size_t getRegistryMemoryFootprint();
+
+    /// Only used by the registry, use get() instead
+    DataDescriptor(std::string_view name, std::string_view help, std::string_view ownerClass,
+                   std::string_view group, std::string_view widget);
+
+    DataDescriptor(const DataDescriptor&) = delete;
+    DataDescriptor& operator=(const DataDescriptor&) = delete;
+
+private:
+    const std::string m_name;
+    const std::string m_help;
+    const std::string m_ownerClass;
+    const std::string m_group;
+    const std::string m_widget;
+};
+
+} // namespace sofa::core::objectmodel
@@ -0,0 +1,87 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/core/objectmodel/DataMemoryReport.h>
+#include <sofa/core/objectmodel/Base.h>
+#include <sofa/core/objectmodel/BaseData.h>
+#include <sofa/core/objectmodel/DataDescriptor.h>
+
+#include <ostream>
+
+namespace sofa::core::objectmodel
+{
+
+namespace
+{
+
+std::size_t stringMemory(const std::string& s)
+{
+    // strings short enough to be stored in the object itself do not use the heap
+    return sizeof(std::string) + (s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0);
+}
+
+} // anonymous namespace
+
+void DataMemoryReport::addComponent(const Base* component)
+{
+    ++nbComponents;
+    for (const BaseData* data : component->getDataFields())
+        addData(data);
+}
+
+void DataMemoryReport::addData(const BaseData* data)
+{
+    ++nbData;
+    dataBytes += sizeof(BaseData);
+
+    const std::size_t linksMemory = data->getLinksHeapMemory();
+    linksHeapBytes += linksMemory;
+    if (linksMemory > 0)
+        ++nbDataWithHeapLinks;
+
+    const DataDescriptor* descriptor = data->getDescriptor();
+    unsharedMetadataBytes += stringMemory(descriptor->getName()) + stringMemory(descriptor->getHelp())
+            + stringMemory(descriptor->getOwnerClass()) + stringMemory(descriptor->getGroup())
+            + stringMemory(descriptor->getWidget());
+}
+
+std::size_t DataMemoryReport::getNbDescriptors()
+{
+    return DataDescriptor::getNbDescriptors();
+}
+
+std::size_t DataMemoryReport::getDescriptorsBytes()
+{
+    return DataDescriptor::getRegistryMemoryFootprint();
+}
+
+std::ostream& operator<<(std::ostream& out, const DataMemoryReport& report)
+{
+    out << report.nbData << " Data in " << report.nbComponents << " components:" << msgendl
+        << "  Data objects (without values): " << report.dataBytes << " bytes" << msgendl
+        << "  links on the heap: " << report.linksHeapBytes << " bytes (" << report.nbDataWithHeapLinks << " Data)" << msgendl
+        << "  shared metadata: " << DataMemoryReport::getDescriptorsBytes() << " bytes in "
+        << DataMemoryReport::getNbDescriptors() << " descriptors (" << report.unsharedMetadataBytes
+        << " bytes if stored in each Data)";
+    return out;
+}
+
+} // namespace sofa::core::objectmodel
@@ -0,0 +1,71 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/core/config.h>
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace sofa::core::objectmodel
+{
+
+class Base;
+class BaseData;
+
+/**
+ *  \brief Memory used by the Data of a set of components, excluding their values.
+ *
+ *  Usage:
+ *  @code
+ *  DataMemoryReport report;
+ *  for (auto* object : objects)
+ *      report.addComponent(object);
+ *  msg_info() << report;
+ *  @endcode
+ */
+struct SOFA_CORE_API DataMemoryReport
+{
+    std::size_t nbComponents { 0 };
+    std::size_t nbData { 0 };
+    /// Number of Data whose lists of links do not fit in their inline storage
+    std::size_t nbDataWithHeapLinks { 0 };
+
+    /// Size of the BaseData part of the Data objects
+    std::size_t dataBytes { 0 };
+    /// Heap memory of the lists of links of the data dependency graph
+    std::size_t linksHeapBytes { 0 };
+    /// Memory the metadata (name, help, group, widget, owner class) would use if each Data stored its own copy
+    std::size_t unsharedMetadataBytes { 0 };
+
+    void addComponent(const Base* component);
+    void addData(const BaseData* data);
+
+    /// Number of shared metadata descriptors (all the Data of the program)
+    static std::size_t getNbDescriptors();
+    /// Memory used by the shared metadata descriptors (all the Data of the program)
+    static std::size_t getDescriptorsBytes();
+};
+
+SOFA_CORE_API std::ostream& operator<<(std::ostream& out, const DataMemoryReport& report);
+
+} // namespace sofa::core::objectmodel
@@ -0,0 +1,146 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/helper/ScratchArena.h>
+using sofa::helper::ScratchArena ;
+using sofa::helper::ScratchVector ;
+
+#include <sofa/testing/AllocationCounter.h>
+using sofa::testing::ScopedHeapAllocationCounter ;
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+SOFA_TESTING_COUNT_HEAP_ALLOCATIONS()
+
+namespace
+{
+
+/// Mimic the temporaries of a time step
+void fakeStep(ScratchArena& arena, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ScratchArena::Scope scope(arena);
+        double* values = arena.allocate<double>(100 + i);
+        values[0] = 1.0;
+        ScratchVector<int> indices { sofa::helper::ScratchAllocator<int>(arena) };
+        indices.resize(50 + i);
+    }
+    // kept until the end of the step
+    arena.allocate<double>(n * 1000);
+}
+
+}
+
+TEST(ScratchArena, alignment)
+{
+    ScratchArena arena;
+    arena.allocate(1);
+    void* p = arena.allocate(24, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+    arena.allocate(3);
+    double* d = arena.allocate<double>(4);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0u);
+}
+
+TEST(ScratchArena, scopeRewinds)
+{
+    ScratchArena arena;
+    arena.allocate(128);
+    const std::size_t used = arena.getUsedBytes();
+    void* first = nullptr;
+    {
+        ScratchArena::Scope scope(arena);
+        first = arena.allocate(1000);
+        EXPECT_GT(arena.getUsedBytes(), used);
+    }
+    EXPECT_EQ(arena.getUsedBytes(), used);
+
+    // the same memory is given again
+    ScratchArena::Scope scope(arena);
+    EXPECT_EQ(arena.allocate(1000), first);
+}
+
+TEST(ScratchArena, resetMergesBlocks)
+{
+    ScratchArena arena;
+    // larger than the first block
+    arena.allocate(100 * 1024);
+    arena.allocate(300 * 1024);
+    const std::size_t capacity = arena.getCapacity();
+    const std::size_t nbHeapAllocations = arena.getNbHeapAllocations();
+    EXPECT_GE(nbHeapAllocations, 2u);
+
+    arena.reset();
+    EXPECT_EQ(arena.getUsedBytes(), 0u);
+    EXPECT_EQ(arena.getCapacity(), capacity);
+    EXPECT_EQ(arena.getNbHeapAllocations(), nbHeapAllocations + 1);
+
+    // the same amount of memory now fits in the merged block
+    arena.allocate(100 * 1024);
+    arena.allocate(300 * 1024);
+    EXPECT_EQ(arena.getNbHeapAllocations(), nbHeapAllocations + 1);
+}
+
+TEST(ScratchArena, steadyStateDoesNotAllocate)
+{
+    // the blocks are counted by the allocation counter
+    ScopedHeapAllocationCounter creation;
+    ScratchArena arena(1024);
+    EXPECT_EQ(creation.getCount(), arena.getNbHeapAllocations() + 1); // + the list of blocks
+
+    // warm up: the arena grows during the first steps
+    fakeStep(arena, 100);
+    arena.reset();
+    fakeStep(arena, 100);
+    arena.reset();
+
+    ScopedHeapAllocationCounter counter;
+    for (int step = 0; step < 10; ++step)
+    {
+        fakeStep(arena, 100);
+        arena.reset();
+    }
+    EXPECT_EQ(counter.getCount(), 0u);
+}
+
+TEST(ScratchArena, threadLocal)
+{
+    ScratchArena* mainArena = &ScratchArena::getThreadLocal();
+    ScratchArena* otherArena = nullptr;
+    std::thread thread([&otherArena]()
+    {
+        otherArena = &ScratchArena::getThreadLocal();
+        otherArena->allocate(10);
+    });
+    thread.join();
+    EXPECT_NE(mainArena, otherArena);
+
+    ScratchVector<double> v(10, 1.0);
+    EXPECT_EQ(v.get_allocator().getArena(), mainArena);
+    EXPECT_GT(mainArena->getUsedBytes(), 0u);
+
+    ScratchArena::resetAll();
+    EXPECT_EQ(mainArena->getUsedBytes(), 0u);
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/helper/SmallVector.h>
+using sofa::helper::SmallVector;
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace
+{
+
+TEST(SmallVector_test, inlineStorage)
+{
+    SmallVector<int, 2> v;
+    EXPECT_TRUE(v.empty());
+    v.push_back(1);
+    v.push_back(2);
+    EXPECT_EQ(v.size(), 2u);
+    EXPECT_EQ(v.capacity(), 2u);
+    EXPECT_EQ(v.getHeapMemory(), 0u);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v.back(), 2);
+}
+
+TEST(SmallVector_test, growOnHeap)
+{
+    SmallVector<int, 1> v;
+    for (int i = 0; i < 10; ++i)
+        v.push_back(i);
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_GT(v.getHeapMemory(), 0u);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(v[i], i);
+
+    v.clear();
+    v.push_back(3);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.getHeapMemory(), 0u);
+    EXPECT_EQ(v.front(), 3);
+}
+
+TEST(SmallVector_test, erase)
+{
+    SmallVector<int, 1> v;
+    for (int i = 0; i < 5; ++i)
+        v.push_back(i);
+
+    v.erase(std::find(v.begin(), v.end(), 2));
+    ASSERT_EQ(v.size(), 4u);
+    EXPECT_EQ(v[2], 3);
+
+    v.erase(v.begin(), v.begin() + 2);
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[0], 3);
+    EXPECT_EQ(v[1], 4);
+}
+
+TEST(SmallVector_test, copy)
+{
+    SmallVector<int, 1> a;
+    a.push_back(1);
+    a.push_back(2);
+
+    SmallVector<int, 1> b(a);
+    EXPECT_EQ(a, b);
+    b.pop_back();
+    EXPECT_NE(a, b);
+
+    b = a;
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a.data(), b.data());
+}
+
+} // namespace
@@ -0,0 +1,196 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/helper/ScratchArena.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace sofa::helper
+{
+
+namespace
+{
+
+/// Size of the first block of an arena
+constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+/// Arenas of all the threads, to reset them between two time steps
+struct ArenaRegistry
+{
+    std::mutex mutex;
+    std::vector<ScratchArena*> arenas;
+};
+
+ArenaRegistry& getArenaRegistry()
+{
+    static ArenaRegistry registry;
+    return registry;
+}
+
+struct RegisteredArena
+{
+    ScratchArena arena;
+
+    RegisteredArena()
+    {
+        ArenaRegistry& registry = getArenaRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.arenas.push_back(&arena);
+    }
+
+    ~RegisteredArena()
+    {
+        ArenaRegistry& registry = getArenaRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.arenas.erase(std::remove(registry.arenas.begin(), registry.arenas.end(), &arena), registry.arenas.end());
+    }
+};
+
+std::size_t alignOffset(const char* base, std::size_t offset, std::size_t alignment)
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(base) + offset;
+    const std::uintptr_t aligned = (address + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+    return offset + (std::size_t)(aligned - address);
+}
+
+} // anonymous namespace
+
+
+ScratchArena::Scope::Scope()
+    : Scope(ScratchArena::getThreadLocal())
+{
+}
+
+ScratchArena::Scope::Scope(ScratchArena& arena)
+    : m_arena(arena)
+    , m_marker(arena.getMarker())
+{
+}
+
+ScratchArena::Scope::~Scope()
+{
+    m_arena.rewind(m_marker);
+}
+
+
+ScratchArena::ScratchArena(std::size_t initialCapacity)
+{
+    m_blocks.reserve(8);
+    if (initialCapacity > 0)
+        addBlock(initialCapacity);
+}
+
+ScratchArena::~ScratchArena()
+{
+    for (Block& block : m_blocks)
+        delete[] block.data;
+}
+
+void ScratchArena::addBlock(std::size_t minSize)
+{
+    const std::size_t lastSize = m_blocks.empty() ? 0 : m_blocks.back().size;
+    const std::size_t size = std::max({ minSize, 2 * lastSize, defaultBlockSize });
+    m_blocks.push_back({ new char[size], size });
+    ++m_nbHeapAllocations;
+}
+
+void* ScratchArena::allocate(std::size_t nbBytes, std::size_t alignment)
+{
+    if (nbBytes == 0) nbBytes = 1;
+
+    while (m_current < m_blocks.size())
+    {
+        Block& block = m_blocks[m_current];
+        const std::size_t begin = alignOffset(block.data, m_offset, alignment);
+        if (begin + nbBytes <= block.size)
+        {
+            m_offset = begin + nbBytes;
+            return block.data + begin;
+        }
+        // try the next block, kept from a previous rewind
+        ++m_current;
+        m_offset = 0;
+    }
+
+    // new[] returns memory aligned for any fundamental type, larger alignments are handled by padding
+    addBlock(nbBytes + alignment);
+    m_current = m_blocks.size() - 1;
+    Block& block = m_blocks[m_current];
+    const std::size_t begin = alignOffset(block.data, 0, alignment);
+    m_offset = begin + nbBytes;
+    return block.data + begin;
+}
+
+void ScratchArena::rewind(const Marker& marker)
+{
+    m_current = marker.block;
+    m_offset = marker.offset;
+}
+
+void ScratchArena::reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        // merge the blocks so that the next step fits in a single one
+        const std::size_t capacity = getCapacity();
+        for (Block& block : m_blocks)
+            delete[] block.data;
+        m_blocks.clear();
+        m_blocks.push_back({ new char[capacity], capacity });
+        ++m_nbHeapAllocations;
+    }
+    m_current = 0;
+    m_offset = 0;
+}
+
+std::size_t ScratchArena::getCapacity() const
+{
+    std::size_t capacity = 0;
+    for (const Block& block : m_blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+std::size_t ScratchArena::getUsedBytes() const
+{
+    std::size_t used = m_offset;
+    for (std::size_t b = 0; b < m_current && b < m_blocks.size(); ++b)
+        used += m_blocks[b].size;
+    return used;
+}
+
+ScratchArena& ScratchArena::getThreadLocal()
+{
+    thread_local RegisteredArena threadArena;
+    return threadArena.arena;
+}
+
+void ScratchArena::resetAll()
+{
+    ArenaRegistry& registry = getArenaRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (ScratchArena* arena : registry.arenas)
+        arena->reset();
+}
+
+} // namespace sofa::helper
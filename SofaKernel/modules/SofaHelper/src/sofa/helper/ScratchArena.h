@@ -0,0 +1,162 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/helper/config.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sofa::helper
+{
+
+/**
+ *  \brief Monotonic memory arena for the temporaries of the hot loops (force fields, mappings, solvers).
+ *
+ *  Memory is taken by bumping an offset in a large block and is never given back individually.
+ *  The arenas are reset once per time step (see resetAll, called by Simulation::animate before the
+ *  AnimateBeginEvent is sent). When a block is full, a new one is allocated; at the next reset the
+ *  blocks are merged into a single one large enough for a whole step, so that the steady state does
+ *  not allocate anything on the heap.
+ *
+ *  Each thread has its own arena (getThreadLocal), so that allocating does not require any lock.
+ *  A ScratchArena::Scope rewinds the arena when destroyed, to reuse the memory of the temporaries
+ *  living shorter than a step.
+ *
+ *  @warning scratch memory must not be kept from one time step to the next.
+ */
+class SOFA_HELPER_API ScratchArena
+{
+public:
+    /// Position in the arena, used to rewind it
+    struct Marker
+    {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    /// Rewind an arena to its current position at the end of the scope
+    class SOFA_HELPER_API Scope
+    {
+    public:
+        Scope();
+        explicit Scope(ScratchArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArena& m_arena;
+        Marker m_marker;
+    };
+
+    explicit ScratchArena(std::size_t initialCapacity = 0);
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /// Uninitialized memory of nbBytes bytes, aligned on alignment (a power of 2)
+    void* allocate(std::size_t nbBytes, std::size_t alignment = alignof(std::max_align_t));
+
+    /// Uninitialized memory for n objects of type T
+    template<class T>
+    T* allocate(std::size_t n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "scratch memory is released without calling any destructor");
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    Marker getMarker() const { return { m_current, m_offset }; }
+
+    /// Forget the allocations done since the marker was taken
+    void rewind(const Marker& marker);
+
+    /// Forget every allocation. The blocks are merged into a single one.
+    void reset();
+
+    /// Total size of the blocks
+    std::size_t getCapacity() const;
+
+    /// Number of bytes currently in use, counting the previous blocks as full
+    std::size_t getUsedBytes() const;
+
+    /// Number of blocks allocated on the heap since the creation of the arena
+    std::size_t getNbHeapAllocations() const { return m_nbHeapAllocations; }
+
+    /// Arena of the calling thread
+    static ScratchArena& getThreadLocal();
+
+    /// Reset the arenas of all the threads.
+    /// Must be called while no thread is using its arena, typically between two time steps.
+    static void resetAll();
+
+private:
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minSize);
+
+    std::vector<Block> m_blocks;
+    std::size_t m_current { 0 };
+    std::size_t m_offset { 0 };
+    std::size_t m_nbHeapAllocations { 0 };
+};
+
+
+/// Standard allocator drawing from a ScratchArena (the arena of the calling thread by default).
+/// Deallocation does nothing: the memory comes back when the arena is rewound or reset.
+template<class T>
+class ScratchAllocator
+{
+public:
+    typedef T value_type;
+
+    ScratchAllocator() noexcept : m_arena(&ScratchArena::getThreadLocal()) {}
+    explicit ScratchAllocator(ScratchArena& arena) noexcept : m_arena(&arena) {}
+    template<class U>
+    ScratchAllocator(const ScratchAllocator<U>& other) noexcept : m_arena(other.getArena()) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    ScratchArena* getArena() const noexcept { return m_arena; }
+
+    template<class U>
+    bool operator==(const ScratchAllocator<U>& other) const noexcept { return m_arena == other.getArena(); }
+    template<class U>
+    bool operator!=(const ScratchAllocator<U>& other) const noexcept { return m_arena != other.getArena(); }
+
+private:
+    ScratchArena* m_arena;
+};
+
+/// Vector whose storage is taken from the scratch arena of the calling thread
+template<class T>
+using ScratchVector = std::vector<T, ScratchAllocator<T> >;
+
+} // namespace sofa::helper
@@ -0,0 +1,189 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU General Public License as published by the Free  *
+* Software Foundation; either version 2 of the License, or (at your option)   *
+* any later version.                                                          *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for    *
+* more details.                                                               *
+*                                                                             *
+* You should have received a copy of the GNU General Public License along     *
+* with this program. If not, see <http://www.gnu.org/licenses/>.              *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/helper/config.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace sofa::helper
+{
+
+/**
+ *  \brief Vector storing up to N elements inside the object itself, and only using the heap beyond.
+ *
+ *  Meant for the many small lists of pointers or indices held by each instance of a frequently
+ *  instanciated class (e.g. the links of the DDGNode), which most of the time contain zero or one element.
+ *  With N=1 it is as large as a std::vector but does not allocate anything until a second element is added.
+ *
+ *  Only trivially copyable types are supported: the elements are moved with memcpy.
+ */
+template<class T, std::size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only stores trivially copyable types");
+    static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    SmallVector() = default;
+
+    SmallVector(const SmallVector& other)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        if (!isInline())
+            std::free(m_data);
+    }
+
+    iterator begin() { return m_data; }
+    iterator end() { return m_data + m_size; }
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    const_iterator cbegin() const { return m_data; }
+    const_iterator cend() const { return m_data + m_size; }
+
+    size_type size() const { return m_size; }
+    size_type capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+
+    T& operator[](size_type i) { assert(i < m_size); return m_data[i]; }
+    const T& operator[](size_type i) const { assert(i < m_size); return m_data[i]; }
+    T& front() { assert(m_size > 0); return m_data[0]; }
+    const T& front() const { assert(m_size > 0); return m_data[0]; }
+    T& back() { assert(m_size > 0); return m_data[m_size-1]; }
+    const T& back() const { assert(m_size > 0); return m_data[m_size-1]; }
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+
+    void push_back(const T& value)
+    {
+        if (m_size == m_capacity)
+        {
+            const T copy = value; // value may be an element of this vector
+            reserve(2 * m_capacity);
+            m_data[m_size++] = copy;
+        }
+        else
+            m_data[m_size++] = value;
+    }
+
+    void pop_back() { assert(m_size > 0); --m_size; }
+
+    iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        iterator f = m_data + (first - m_data);
+        const std::size_t nbErased = last - first;
+        if (nbErased > 0)
+        {
+            std::memmove(f, last, (end() - last) * sizeof(T));
+            m_size -= (size_type)nbErased;
+        }
+        return f;
+    }
+
+    void clear() { m_size = 0; }
+
+    void reserve(size_type n)
+    {
+        if (n <= m_capacity)
+            return;
+        T* data = static_cast<T*>(std::malloc(n * sizeof(T)));
+        if (!data)
+            throw std::bad_alloc();
+        std::memcpy(data, m_data, m_size * sizeof(T));
+        if (!isInline())
+            std::free(m_data);
+        m_data = data;
+        m_capacity = n;
+    }
+
+    /// Give the heap memory back if the elements fit in the inline storage again
+    void shrink_to_fit()
+    {
+        if (isInline() || m_size > N)
+            return;
+        T* data = m_data;
+        std::memcpy(m_inline, data, m_size * sizeof(T));
+        std::free(data);
+        m_data = m_inline;
+        m_capacity = N;
+    }
+
+    template<class InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        reserve((size_type)std::distance(first, last));
+        for (; first != last; ++first)
+            m_data[m_size++] = *first;
+    }
+
+    /// Memory allocated on the heap, in bytes
+    std::size_t getHeapMemory() const
+    {
+        return isInline() ? 0 : m_capacity * sizeof(T);
+    }
+
+    bool operator==(const SmallVector& other) const
+    {
+        return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const SmallVector& other) const { return !(*this == other); }
+
+private:
+    bool isInline() const { return m_data == m_inline; }
+
+    T* m_data { m_inline };
+    unsigned int m_size { 0 };
+    unsigned int m_capacity { N };
+    T m_inline[N];
+};
+
+} // namespace sofa::helper
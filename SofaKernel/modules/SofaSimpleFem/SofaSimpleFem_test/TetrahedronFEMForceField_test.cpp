@@ -24,6 +24,9 @@
 
 #include <SofaTest/TestMessageHandler.h>
 
+#include <sofa/testing/AllocationCounter.h>
+using sofa::testing::ScopedHeapAllocationCounter ;
+
 #include <SofaSimulationGraph/DAGSimulation.h>
 using sofa::core::objectmodel::ComponentState ;
 using sofa::core::objectmodel::BaseObject ;
@@ -35,6 +38,8 @@ using sofa::simulation::SceneLoaderXML ;
 
 using sofa::core::execparams::defaultInstance; 
 
+SOFA_TESTING_COUNT_HEAP_ALLOCATIONS()
+
 namespace sofa {
 
 using namespace modeling;
@@ -107,6 +112,30 @@ struct TetrahedronFEMForceField_test : public ForceField_test<_TetrahedronFEMFor
         Inherited::run_test( x, v, f );
     }
 
+    // The product by the stiffness matrix is done at each iteration of the linear solvers:
+    // it must not allocate anything once the vectors have their size
+    void test_addDForceDoesNotAllocate()
+    {
+        Inherited::run_test( x, v, f );
+
+        core::MechanicalParams mparams;
+        mparams.setKFactor(1.0);
+
+        typename ForceType::DataVecDeriv dx, df;
+        {
+            helper::WriteAccessor<typename ForceType::DataVecDeriv> wdx = dx;
+            wdx.resize(x.size());
+            for (unsigned int i=0; i<x.size(); i++)
+                DataTypes::set( wdx[i], (Real)0.1*i, (Real)-0.2, (Real)0.05*i );
+        }
+        Inherited::force->addDForce(&mparams, df, dx);
+
+        ScopedHeapAllocationCounter counter;
+        for (int i=0; i<10; i++)
+            Inherited::force->addDForce(&mparams, df, dx);
+        EXPECT_EQ(counter.getCount(), 0u);
+    }
+
     void checkGracefullHandlingWhenTopologyIsMissing()
     {
         this->clearSceneGraph();
@@ -165,6 +194,14 @@ TYPED_TEST( TetrahedronFEMForceField_test , extension )
     this->test_valueForce();
 }
 
+TYPED_TEST( TetrahedronFEMForceField_test , addDForceDoesNotAllocate )
+{
+    this->errorMax *= 1e6;
+    this->deltaRange = std::make_pair( 1, this->errorMax * 10 );
+
+    this->test_addDForceDoesNotAllocate();
+}
+
 TYPED_TEST(TetrahedronFEMForceField_test, checkGracefullHandlingWhenTopologyIsMissing)
 {
     this->checkGracefullHandlingWhenTopologyIsMissing();
@@ -0,0 +1,74 @@
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/helper/testing/BaseTest.h>
+
+#include <atomic>
+#include <vector>
+
+namespace sofa
+{
+
+    // count how many times each index of [0,N) is visited
+    static std::vector<int> VisitCounts(int N, int nbThread, int grainSize)
+    {
+        simulation::TaskScheduler* scheduler = simulation::TaskScheduler::create(simulation::DefaultTaskScheduler::name());
+        scheduler->init(nbThread);
+
+        std::vector< std::atomic<int> > counts(N);
+        for (auto& c : counts) c = 0;
+        simulation::parallelForEach(scheduler, 0, N, [&counts](int i) { ++counts[i]; }, grainSize);
+
+        scheduler->stop();
+        return std::vector<int>(counts.begin(), counts.end());
+    }
+
+
+    TEST(ParallelForEachTests, VisitEachIndexOnceSingle)
+    {
+        const std::vector<int> counts = VisitCounts(10000, 1, 1);
+        for (int c : counts)
+            EXPECT_EQ(c, 1);
+    }
+
+    TEST(ParallelForEachTests, VisitEachIndexOnceMulti)
+    {
+        const std::vector<int> counts = VisitCounts(10000, 4, 16);
+        for (int c : counts)
+            EXPECT_EQ(c, 1);
+    }
+
+    TEST(ParallelForEachTests, RangesAreContiguousAndRespectGrainSize)
+    {
+        simulation::TaskScheduler* scheduler = simulation::TaskScheduler::create(simulation::DefaultTaskScheduler::name());
+        scheduler->init(4);
+
+        const int N = 1000;
+        const int grainSize = 100;
+        std::atomic<int> nbRanges(0);
+        std::atomic<int> nbIterations(0);
+        std::atomic<bool> tooSmall(false);
+        simulation::parallelForEachRange(scheduler, 0, N, [&](int begin, int end)
+        {
+            ++nbRanges;
+            nbIterations += end - begin;
+            if (end - begin < grainSize) tooSmall = true;
+        }, grainSize);
+
+        scheduler->stop();
+        EXPECT_EQ(nbIterations.load(), N);
+        EXPECT_LE(nbRanges.load(), N / grainSize);
+        EXPECT_FALSE(tooSmall.load());
+    }
+
+    TEST(ParallelForEachTests, EmptyRangeAndNoScheduler)
+    {
+        int nbCalls = 0;
+        simulation::parallelForEachRange(nullptr, 5, 5, [&](int, int) { ++nbCalls; });
+        EXPECT_EQ(nbCalls, 0);
+
+        int sum = 0;
+        simulation::parallelForEach(nullptr, 0, 10, [&](int i) { sum += i; });
+        EXPECT_EQ(sum, 45);
+    }
+
+} // namespace sofa
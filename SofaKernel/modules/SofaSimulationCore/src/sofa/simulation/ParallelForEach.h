@@ -0,0 +1,104 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/TaskScheduler.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace sofa::simulation
+{
+
+/// Task calling a functor on the [first,last) sub-range of a loop.
+/// The functor is referenced, not copied: it must outlive the task.
+template<class Index, class Function>
+class RangeTask : public CpuTask
+{
+public:
+    RangeTask(CpuTask::Status* status, Index first, Index last, const Function& function)
+        : CpuTask(status)
+        , m_first(first)
+        , m_last(last)
+        , m_function(function)
+    {
+    }
+
+    MemoryAlloc run() override
+    {
+        m_function(m_first, m_last);
+        return MemoryAlloc::Dynamic;
+    }
+
+private:
+    Index m_first;
+    Index m_last;
+    const Function& m_function;
+};
+
+/// Split [first,last) into contiguous ranges of at least grainSize iterations and call
+/// function(begin, end) on each of them from the threads of the scheduler.
+/// The calling thread takes part in the work and returns once every range is processed.
+/// Without scheduler, with a single thread or for a small loop, function(first, last) is
+/// called directly.
+template<class Index, class Function>
+void parallelForEachRange(TaskScheduler* scheduler, Index first, Index last, const Function& function, Index grainSize = 1)
+{
+    if (!(first < last)) return;
+
+    const std::uint64_t nbIterations = (std::uint64_t)(last - first);
+    const std::uint64_t grain = std::max<std::uint64_t>((std::uint64_t)grainSize, 1);
+    const unsigned int nbThreads = scheduler ? scheduler->getThreadCount() : 1;
+    if (nbThreads < 2 || nbIterations <= grain)
+    {
+        function(first, last);
+        return;
+    }
+
+    // a few ranges per thread so that work stealing can balance uneven iterations
+    const std::uint64_t nbRanges = std::min<std::uint64_t>((nbIterations + grain - 1) / grain, 4 * (std::uint64_t)nbThreads);
+
+    CpuTask::Status status;
+    Index begin = first;
+    for (std::uint64_t r = 0; r < nbRanges; ++r)
+    {
+        const Index end = (Index)(first + (Index)(nbIterations * (r + 1) / nbRanges));
+        scheduler->addTask(new RangeTask<Index, Function>(&status, begin, end, function));
+        begin = end;
+    }
+    scheduler->workUntilDone(&status);
+}
+
+/// Call function(i) for each i in [first,last), from the threads of the scheduler.
+/// @see parallelForEachRange
+template<class Index, class Function>
+void parallelForEach(TaskScheduler* scheduler, Index first, Index last, const Function& function, Index grainSize = 1)
+{
+    const auto loop = [&function](Index begin, Index end)
+    {
+        for (Index i = begin; i < end; ++i)
+            function(i);
+    };
+    parallelForEachRange(scheduler, first, last, loop, grainSize);
+}
+
+} // namespace sofa::simulation
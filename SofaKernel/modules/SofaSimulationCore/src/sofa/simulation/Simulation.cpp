@@ -49,6 +49,7 @@
 #include <sofa/simulation/Node.h>
 #include <sofa/helper/system/SetDirectory.h>
 #include <sofa/helper/AdvancedTimer.h>
+#include <sofa/helper/ScratchArena.h>
 #include <sofa/helper/init.h>
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/core/ObjectFactory.h>
@@ -235,6 +236,9 @@ void Simulation::animate ( Node* root, SReal dt )
     sofa::core::behavior::BaseAnimationLoop* aloop = root->getAnimationLoop();
     if(aloop)
     {
+        // the temporaries of the previous step are not used anymore
+        sofa::helper::ScratchArena::resetAll();
+
         aloop->step(params,dt);
     }
     else
@@ -0,0 +1,15 @@
+#!/bin/bash
+# Scaling benchmark of the preconditioners of ShewchukPCGLinearSolver.
+# For each resolution and each preconditioner, the scene is generated and run in batch mode for 100 steps.
+# The timings and the "PCG iterations" value of each step are written in the log file by the AdvancedTimer.
+for p in BlockJacobiPreconditioner SSORPreconditioner AMGPreconditioner;
+do
+for i in 1 2 3 4 6 8;
+do
+export s=$i
+export p
+echo $p - $i
+php examples/Benchmark/Performance/Bar-fem-implicit-preconditioners.pscn > examples/Benchmark/Performance/Bar-fem-implicit-preconditioners.scn
+runSofa -g batch -n 100 --computationTimeSampling 1 examples/Benchmark/Performance/Bar-fem-implicit-preconditioners.scn > examples/Benchmark/Performance/Bar-$i-fem-implicit-$p-log.txt 2>&1
+done
+done
@@ -0,0 +1,161 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#ifndef SOFA_COMPONENT_LINEARSOLVER_AMGPRECONDITIONER_H
+#define SOFA_COMPONENT_LINEARSOLVER_AMGPRECONDITIONER_H
+#include <SofaPreconditioner/config.h>
+
+#include <sofa/core/behavior/LinearSolver.h>
+#include <SofaBaseLinearSolver/MatrixLinearSolver.h>
+#include <SofaBaseLinearSolver/CompressedRowSparseMatrix.h>
+#include <SofaBaseLinearSolver/FullVector.h>
+#include <sofa/helper/vector.h>
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <Eigen/Dense>
+
+namespace sofa
+{
+
+namespace component
+{
+
+namespace linearsolver
+{
+
+/// Linear system solver / preconditioner based on smoothed aggregation algebraic multigrid.
+///
+/// The hierarchy is built from the assembled block matrix (3x3 blocks for 3D elasticity). Nodes are
+/// aggregated using the strength of the coupling between blocks, and the tentative prolongators are
+/// built from the near-nullspace of the operator. When a single mechanical state is attached to the
+/// solver, the six rigid body modes computed from its rest positions are used, which is required to
+/// obtain a good convergence rate for elasticity problems. Otherwise only translations are used.
+///
+/// One application of the solver performs a single symmetric V-cycle (forward Gauss-Seidel pre-smoothing,
+/// backward Gauss-Seidel post-smoothing and a direct solve on the coarsest level), so it can be used as a
+/// preconditioner of ShewchukPCGLinearSolver.
+/// The aggregates and tentative prolongators are reused as long as the sparsity pattern of the matrix is
+/// unchanged: only the numerical (Galerkin) part of the setup is recomputed in this case.
+template<class TMatrix, class TVector>
+class AMGPreconditioner : public sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector>
+{
+public:
+    SOFA_CLASS(SOFA_TEMPLATE2(AMGPreconditioner,TMatrix,TVector),SOFA_TEMPLATE2(sofa::component::linearsolver::MatrixLinearSolver,TMatrix,TVector));
+
+    typedef TMatrix Matrix;
+    typedef TVector Vector;
+    typedef typename Matrix::Index Index;
+    typedef typename Matrix::Real Real;
+    typedef sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector> Inherit;
+
+    typedef Eigen::SparseMatrix<Real, Eigen::RowMajor> EigenSparseMatrix;
+    typedef Eigen::SparseMatrix<Real, Eigen::ColMajor> EigenColSparseMatrix;
+    typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> EigenVector;
+    typedef Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> EigenDenseMatrix;
+
+    Data<unsigned> d_maxLevels; ///< Maximum number of levels in the hierarchy
+    Data<unsigned> d_coarsestSize; ///< Number of unknowns under which a level is solved directly
+    Data<Real> d_strengthThreshold; ///< Threshold on the normalized block coupling used to build the aggregates
+    Data<unsigned> d_smoothingSteps; ///< Number of Gauss-Seidel sweeps before and after each coarse grid correction
+    Data<Real> d_prolongatorDamping; ///< Damping factor of the prolongator smoothing, divided by the spectral radius of D^-1 A
+    Data<bool> d_useRigidBodyModes; ///< Use the rigid body modes computed from the rest positions as near-nullspace
+    Data<bool> d_reuseSetup; ///< Reuse the aggregates while the sparsity pattern of the matrix is unchanged
+    Data<helper::vector<unsigned> > d_levelSizes; ///< Output: number of unknowns of each level of the hierarchy
+
+protected:
+    AMGPreconditioner();
+
+public:
+    void solve (Matrix& M, Vector& x, Vector& b) override;
+    void invert(Matrix& M) override;
+
+    MatrixInvertData * createInvertData() override
+    {
+        return new AMGPreconditionerInvertData();
+    }
+
+protected:
+
+    /// One level of the multigrid hierarchy
+    struct Level
+    {
+        EigenSparseMatrix A;     ///< operator of this level
+        EigenSparseMatrix Ptent; ///< tentative prolongator from the next (coarser) level to this one
+        EigenSparseMatrix P;     ///< smoothed prolongator from the next (coarser) level to this one
+        EigenSparseMatrix R;     ///< restriction, i.e. transpose of P
+        EigenVector invDiag;     ///< inverse of the diagonal of A
+        unsigned blockSize;      ///< number of unknowns per node
+        EigenVector x, b, r;     ///< work vectors used during the V-cycle
+    };
+
+    class AMGPreconditionerInvertData : public MatrixInvertData
+    {
+    public :
+        std::vector<Level> levels;
+        Eigen::SimplicialLDLT<EigenColSparseMatrix> coarseSolver;
+        bool coarseFactorized = false;
+
+        /// sparsity pattern of the matrix used to build the current aggregates
+        typename Matrix::VecIndex rowIndex, rowBegin, colsIndex;
+        bool hasHierarchy = false;
+    };
+
+    /// Convert the block matrix to a scalar Eigen matrix, only the values are updated if the pattern is kept
+    void convertMatrix(const Matrix& M, EigenSparseMatrix& A) const;
+
+    /// Compute the near-nullspace vectors of the finest level
+    void computeNearNullSpace(Index nbNodes, EigenDenseMatrix& B) const;
+
+    /// Group the nodes of a level into aggregates, returns the number of aggregates
+    Index aggregate(const EigenSparseMatrix& A, unsigned blockSize, helper::vector<Index>& nodeAggregate) const;
+
+    /// Build the tentative prolongator from the aggregates and the near-nullspace, and the coarse near-nullspace
+    void buildTentativeProlongator(const helper::vector<Index>& nodeAggregate, Index nbAggregates, unsigned blockSize,
+                                   const EigenDenseMatrix& B, EigenSparseMatrix& Ptent, EigenDenseMatrix& coarseB) const;
+
+    /// Invert the diagonal of the level operator (zero entries are left to zero)
+    void computeInverseDiagonal(Level& level) const;
+
+    /// Smooth the tentative prolongator with a damped Jacobi iteration and compute the coarse operator
+    void computeGalerkinProduct(Level& fine, Level& coarse) const;
+
+    /// Estimate the spectral radius of D^-1 A with a few power iterations
+    Real estimateSpectralRadius(const EigenSparseMatrix& A, const EigenVector& invDiag) const;
+
+    /// Forward (or backward) Gauss-Seidel sweep on A x = b
+    void gaussSeidel(const Level& level, EigenVector& x, const EigenVector& b, bool forward) const;
+
+    /// Recursive V-cycle starting at the given level
+    void vcycle(AMGPreconditionerInvertData* data, std::size_t l) const;
+
+    void setupHierarchy(AMGPreconditionerInvertData* data, Matrix& M);
+    void updateHierarchy(AMGPreconditionerInvertData* data);
+    void factorizeCoarsestLevel(AMGPreconditionerInvertData* data);
+};
+
+} // namespace linearsolver
+
+} // namespace component
+
+} // namespace sofa
+
+#endif
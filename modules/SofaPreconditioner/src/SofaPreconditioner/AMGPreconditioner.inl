@@ -0,0 +1,487 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#ifndef SOFA_COMPONENT_LINEARSOLVER_AMGPRECONDITIONER_INL
+#define SOFA_COMPONENT_LINEARSOLVER_AMGPRECONDITIONER_INL
+#include <SofaPreconditioner/AMGPreconditioner.h>
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/core/objectmodel/BaseContext.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+#include <cmath>
+
+namespace sofa
+{
+
+namespace component
+{
+
+namespace linearsolver
+{
+
+template<class TMatrix, class TVector>
+AMGPreconditioner<TMatrix,TVector>::AMGPreconditioner()
+    : d_maxLevels( initData(&d_maxLevels, (unsigned)10, "maxLevels", "Maximum number of levels in the hierarchy") )
+    , d_coarsestSize( initData(&d_coarsestSize, (unsigned)300, "coarsestSize", "Number of unknowns under which a level is solved directly") )
+    , d_strengthThreshold( initData(&d_strengthThreshold, (Real)0.08, "strengthThreshold", "Threshold on the normalized block coupling used to build the aggregates") )
+    , d_smoothingSteps( initData(&d_smoothingSteps, (unsigned)1, "smoothingSteps", "Number of Gauss-Seidel sweeps before and after each coarse grid correction") )
+    , d_prolongatorDamping( initData(&d_prolongatorDamping, (Real)(4.0/3.0), "prolongatorDamping", "Damping factor of the prolongator smoothing, divided by the spectral radius of D^-1 A") )
+    , d_useRigidBodyModes( initData(&d_useRigidBodyModes, true, "useRigidBodyModes", "Use the rigid body modes computed from the positions of the mechanical state as near-nullspace") )
+    , d_reuseSetup( initData(&d_reuseSetup, true, "reuseSetup", "Reuse the aggregates while the sparsity pattern of the matrix is unchanged") )
+    , d_levelSizes( initData(&d_levelSizes, "levelSizes", "Output: number of unknowns of each level of the hierarchy") )
+{
+    d_levelSizes.setReadOnly(true);
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::convertMatrix(const Matrix& M, EigenSparseMatrix& A) const
+{
+    const typename Matrix::VecIndex& rowIndex = M.getRowIndex();
+    const typename Matrix::VecIndex& rowBegin = M.getRowBegin();
+    const typename Matrix::VecIndex& colsIndex = M.getColsIndex();
+    const typename Matrix::VecBloc& colsValue = M.getColsValue();
+
+    std::vector< Eigen::Triplet<Real> > triplets;
+    triplets.reserve(colsValue.size() * Matrix::NL * Matrix::NC);
+    for (std::size_t xi = 0; xi < rowIndex.size(); ++xi)
+    {
+        const Index i0 = rowIndex[xi] * Matrix::NL;
+        for (Index xj = rowBegin[xi]; xj < rowBegin[xi+1]; ++xj)
+        {
+            const Index j0 = colsIndex[xj] * Matrix::NC;
+            const typename Matrix::Bloc& b = colsValue[xj];
+            for (Index bi = 0; bi < Matrix::NL; ++bi)
+                for (Index bj = 0; bj < Matrix::NC; ++bj)
+                    triplets.emplace_back(i0 + bi, j0 + bj, b[bi][bj]);
+        }
+    }
+    A.resize(M.rowSize(), M.colSize());
+    A.setFromTriplets(triplets.begin(), triplets.end());
+    A.makeCompressed();
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::computeNearNullSpace(Index nbNodes, EigenDenseMatrix& B) const
+{
+    const unsigned bsize = Matrix::NL;
+    const core::behavior::BaseMechanicalState* mstate = this->getContext()->getMechanicalState();
+    const bool rigid = d_useRigidBodyModes.getValue() && bsize == 3
+            && mstate != nullptr && (Index)mstate->getSize() == nbNodes;
+    if (d_useRigidBodyModes.getValue() && !rigid)
+    {
+        msg_info() << "Rigid body modes are not available (the system does not match a single 3D mechanical state), "
+                      "only translations are used as near-nullspace.";
+    }
+
+    B.setZero(nbNodes * bsize, rigid ? 6 : bsize);
+    for (Index i = 0; i < nbNodes; ++i)
+        for (unsigned d = 0; d < bsize; ++d)
+            B(i*bsize + d, d) = 1;
+
+    if (!rigid) return;
+
+    // rotations around the barycenter, to keep the columns well conditioned
+    Real center[3] = { 0, 0, 0 };
+    for (Index i = 0; i < nbNodes; ++i)
+    {
+        center[0] += (Real)mstate->getPX(i);
+        center[1] += (Real)mstate->getPY(i);
+        center[2] += (Real)mstate->getPZ(i);
+    }
+    for (unsigned d = 0; d < 3; ++d) center[d] /= (Real)nbNodes;
+
+    for (Index i = 0; i < nbNodes; ++i)
+    {
+        const Real x = (Real)mstate->getPX(i) - center[0];
+        const Real y = (Real)mstate->getPY(i) - center[1];
+        const Real z = (Real)mstate->getPZ(i) - center[2];
+        // rotation around X: (0, -z, y)
+        B(i*3+1, 3) = -z;  B(i*3+2, 3) =  y;
+        // rotation around Y: (z, 0, -x)
+        B(i*3+0, 4) =  z;  B(i*3+2, 4) = -x;
+        // rotation around Z: (-y, x, 0)
+        B(i*3+0, 5) = -y;  B(i*3+1, 5) =  x;
+    }
+}
+
+template<class TMatrix, class TVector>
+typename AMGPreconditioner<TMatrix,TVector>::Index
+AMGPreconditioner<TMatrix,TVector>::aggregate(const EigenSparseMatrix& A, unsigned blockSize, helper::vector<Index>& nodeAggregate) const
+{
+    const Index nbNodes = (Index)A.rows() / blockSize;
+
+    // squared Frobenius norm of each non-empty block
+    std::vector< Eigen::Triplet<Real> > triplets;
+    triplets.reserve(A.nonZeros());
+    for (Index i = 0; i < (Index)A.outerSize(); ++i)
+        for (typename EigenSparseMatrix::InnerIterator it(A, i); it; ++it)
+            triplets.emplace_back(i / blockSize, (Index)it.col() / blockSize, it.value() * it.value());
+    EigenSparseMatrix S(nbNodes, nbNodes);
+    S.setFromTriplets(triplets.begin(), triplets.end());
+
+    EigenVector diag = EigenVector::Zero(nbNodes);
+    for (Index i = 0; i < nbNodes; ++i)
+        diag[i] = std::sqrt(S.coeff(i, i));
+
+    const Real theta2 = d_strengthThreshold.getValue() * d_strengthThreshold.getValue();
+    auto isStrong = [&](Index i, Index j, Real s)
+    {
+        return i != j && s > theta2 * diag[i] * diag[j];
+    };
+
+    static const Index Unaggregated = std::numeric_limits<Index>::max();
+    nodeAggregate.assign(nbNodes, Unaggregated);
+    Index nbAggregates = 0;
+
+    // pass 1: nodes whose strong neighborhood is entirely free become the root of a new aggregate
+    for (Index i = 0; i < nbNodes; ++i)
+    {
+        if (nodeAggregate[i] != Unaggregated) continue;
+        bool hasStrongNeighbor = false;
+        bool free = true;
+        for (typename EigenSparseMatrix::InnerIterator it(S, i); it && free; ++it)
+        {
+            if (!isStrong(i, (Index)it.col(), it.value())) continue;
+            hasStrongNeighbor = true;
+            free = (nodeAggregate[it.col()] == Unaggregated);
+        }
+        if (!hasStrongNeighbor || !free) continue;
+
+        nodeAggregate[i] = nbAggregates;
+        for (typename EigenSparseMatrix::InnerIterator it(S, i); it; ++it)
+            if (isStrong(i, (Index)it.col(), it.value()))
+                nodeAggregate[it.col()] = nbAggregates;
+        ++nbAggregates;
+    }
+
+    // pass 2: attach the remaining nodes to the aggregate of their strongest aggregated neighbor
+    helper::vector<Index> pass1 = nodeAggregate;
+    for (Index i = 0; i < nbNodes; ++i)
+    {
+        if (pass1[i] != Unaggregated) continue;
+        Real strongest = 0;
+        for (typename EigenSparseMatrix::InnerIterator it(S, i); it; ++it)
+        {
+            if (pass1[it.col()] == Unaggregated || !isStrong(i, (Index)it.col(), it.value())) continue;
+            if (it.value() > strongest)
+            {
+                strongest = it.value();
+                nodeAggregate[i] = pass1[it.col()];
+            }
+        }
+    }
+
+    // pass 3: group the leftovers with their free strong neighbors (or alone if they are isolated)
+    for (Index i = 0; i < nbNodes; ++i)
+    {
+        if (nodeAggregate[i] != Unaggregated) continue;
+        nodeAggregate[i] = nbAggregates;
+        for (typename EigenSparseMatrix::InnerIterator it(S, i); it; ++it)
+            if (nodeAggregate[it.col()] == Unaggregated && isStrong(i, (Index)it.col(), it.value()))
+                nodeAggregate[it.col()] = nbAggregates;
+        ++nbAggregates;
+    }
+
+    return nbAggregates;
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::buildTentativeProlongator(const helper::vector<Index>& nodeAggregate, Index nbAggregates, unsigned blockSize,
+                                                                    const EigenDenseMatrix& B, EigenSparseMatrix& Ptent, EigenDenseMatrix& coarseB) const
+{
+    const Index nbNodes = (Index)nodeAggregate.size();
+    const Index k = (Index)B.cols();
+
+    // bucket the nodes per aggregate
+    helper::vector<Index> aggregateBegin(nbAggregates + 1, 0);
+    for (Index i = 0; i < nbNodes; ++i) ++aggregateBegin[nodeAggregate[i] + 1];
+    for (Index a = 0; a < nbAggregates; ++a) aggregateBegin[a + 1] += aggregateBegin[a];
+    helper::vector<Index> aggregateNodes(nbNodes);
+    {
+        helper::vector<Index> fill(aggregateBegin.begin(), aggregateBegin.end() - 1);
+        for (Index i = 0; i < nbNodes; ++i) aggregateNodes[fill[nodeAggregate[i]]++] = i;
+    }
+
+    std::vector< Eigen::Triplet<Real> > triplets;
+    triplets.reserve(nbNodes * blockSize * k);
+    coarseB.setZero(nbAggregates * k, k);
+
+    EigenDenseMatrix Q;
+    for (Index a = 0; a < nbAggregates; ++a)
+    {
+        const Index first = aggregateBegin[a];
+        const Index nbRows = (aggregateBegin[a + 1] - first) * blockSize;
+        Q.resize(nbRows, k);
+        for (Index n = 0; n < aggregateBegin[a + 1] - first; ++n)
+            Q.middleRows(n * blockSize, blockSize) = B.middleRows(aggregateNodes[first + n] * blockSize, blockSize);
+
+        // modified Gram-Schmidt: the columns that are (numerically) dependent on the previous ones are dropped,
+        // which is the case for rotations of aggregates made of a single or collinear nodes
+        for (Index c = 0; c < k; ++c)
+        {
+            const Real initialNorm = Q.col(c).norm();
+            for (Index p = 0; p < c; ++p)
+            {
+                if (coarseB(a * k + p, p) == 0) continue;
+                const Real r = Q.col(p).dot(Q.col(c));
+                coarseB(a * k + p, c) = r;
+                Q.col(c) -= r * Q.col(p);
+            }
+            const Real norm = Q.col(c).norm();
+            if (initialNorm > 0 && norm > (Real)1e-8 * initialNorm)
+            {
+                Q.col(c) /= norm;
+                coarseB(a * k + c, c) = norm;
+            }
+            else
+            {
+                Q.col(c).setZero();
+            }
+        }
+
+        for (Index n = 0; n < aggregateBegin[a + 1] - first; ++n)
+            for (unsigned d = 0; d < blockSize; ++d)
+                for (Index c = 0; c < k; ++c)
+                    if (Q(n * blockSize + d, c) != 0)
+                        triplets.emplace_back(aggregateNodes[first + n] * blockSize + d, a * k + c, Q(n * blockSize + d, c));
+    }
+
+    Ptent.resize(nbNodes * blockSize, nbAggregates * k);
+    Ptent.setFromTriplets(triplets.begin(), triplets.end());
+    Ptent.makeCompressed();
+}
+
+template<class TMatrix, class TVector>
+typename AMGPreconditioner<TMatrix,TVector>::Real
+AMGPreconditioner<TMatrix,TVector>::estimateSpectralRadius(const EigenSparseMatrix& A, const EigenVector& invDiag) const
+{
+    const Index n = (Index)A.rows();
+    EigenVector v(n), w(n);
+    for (Index i = 0; i < n; ++i) v[i] = (Real)(1 + (i % 7));
+    v.normalize();
+    Real lambda = 1;
+    for (unsigned it = 0; it < 10; ++it)
+    {
+        w = invDiag.cwiseProduct(A * v);
+        lambda = w.norm();
+        if (lambda == 0) return 1;
+        v = w / lambda;
+    }
+    return lambda;
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::computeInverseDiagonal(Level& level) const
+{
+    level.invDiag.resize(level.A.rows());
+    for (Index i = 0; i < (Index)level.A.rows(); ++i)
+    {
+        const Real d = level.A.coeff(i, i);
+        level.invDiag[i] = (d != 0) ? (Real)1 / d : (Real)0;
+    }
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::computeGalerkinProduct(Level& fine, Level& coarse) const
+{
+    const Real omega = d_prolongatorDamping.getValue() / estimateSpectralRadius(fine.A, fine.invDiag);
+
+    EigenSparseMatrix AP = fine.A * fine.Ptent;
+    fine.P = fine.Ptent - (EigenSparseMatrix)(omega * fine.invDiag.asDiagonal() * AP);
+    fine.P.prune((Real)0);
+    fine.R = fine.P.transpose();
+    coarse.A = fine.R * (fine.A * fine.P);
+
+    // unknowns dropped while building the tentative prolongator have an empty row and column
+    for (Index i = 0; i < (Index)coarse.A.rows(); ++i)
+        if (coarse.A.coeff(i, i) == 0)
+            coarse.A.coeffRef(i, i) = 1;
+    coarse.A.makeCompressed();
+
+    computeInverseDiagonal(coarse);
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::setupHierarchy(AMGPreconditionerInvertData* data, Matrix& M)
+{
+    std::vector<Level>& levels = data->levels;
+    levels.resize(1);
+    levels[0].blockSize = Matrix::NL;
+    convertMatrix(M, levels[0].A);
+    computeInverseDiagonal(levels[0]);
+
+    EigenDenseMatrix B, coarseB;
+    computeNearNullSpace(M.rowBSize(), B);
+
+    helper::vector<Index> nodeAggregate;
+    while (levels.size() < d_maxLevels.getValue() && (Index)levels.back().A.rows() > (Index)d_coarsestSize.getValue())
+    {
+        const std::size_t l = levels.size() - 1;
+        const Index nbAggregates = aggregate(levels[l].A, levels[l].blockSize, nodeAggregate);
+        if (5 * nbAggregates * (Index)B.cols() >= 4 * (Index)levels[l].A.rows())
+            break; // the coarsening stagnates, a new level would cost more than it brings
+
+        buildTentativeProlongator(nodeAggregate, nbAggregates, levels[l].blockSize, B, levels[l].Ptent, coarseB);
+        B.swap(coarseB);
+
+        levels.emplace_back();
+        levels.back().blockSize = (unsigned)B.cols();
+        computeGalerkinProduct(levels[l], levels[l + 1]);
+    }
+
+    factorizeCoarsestLevel(data);
+
+    data->rowIndex = M.getRowIndex();
+    data->rowBegin = M.getRowBegin();
+    data->colsIndex = M.getColsIndex();
+    data->hasHierarchy = true;
+
+    helper::vector<unsigned>& sizes = *d_levelSizes.beginEdit();
+    sizes.clear();
+    for (const Level& level : levels) sizes.push_back((unsigned)level.A.rows());
+    d_levelSizes.endEdit();
+    msg_info() << "Hierarchy built with " << levels.size() << " levels: " << d_levelSizes.getValue();
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::updateHierarchy(AMGPreconditionerInvertData* data)
+{
+    std::vector<Level>& levels = data->levels;
+    computeInverseDiagonal(levels[0]);
+
+    for (std::size_t l = 0; l + 1 < levels.size(); ++l)
+        computeGalerkinProduct(levels[l], levels[l + 1]);
+
+    factorizeCoarsestLevel(data);
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::factorizeCoarsestLevel(AMGPreconditionerInvertData* data)
+{
+    EigenColSparseMatrix coarseA = data->levels.back().A;
+    data->coarseSolver.compute(coarseA);
+    data->coarseFactorized = (data->coarseSolver.info() == Eigen::Success);
+    if (!data->coarseFactorized)
+    {
+        msg_warning() << "Factorization of the coarsest level failed, it will be smoothed instead.";
+    }
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::invert(Matrix& M)
+{
+    AMGPreconditionerInvertData * data = (AMGPreconditionerInvertData *) this->getMatrixInvertData(&M);
+    sofa::helper::ScopedAdvancedTimer timer("AMGPreconditioner::invert");
+
+    M.compress();
+    if (M.rowSize() == 0) return;
+
+    const bool samePattern = data->hasHierarchy && d_reuseSetup.getValue()
+            && data->rowIndex == M.getRowIndex()
+            && data->rowBegin == M.getRowBegin()
+            && data->colsIndex == M.getColsIndex();
+
+    if (samePattern)
+    {
+        convertMatrix(M, data->levels[0].A);
+        updateHierarchy(data);
+    }
+    else
+    {
+        setupHierarchy(data, M);
+    }
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::gaussSeidel(const Level& level, EigenVector& x, const EigenVector& b, bool forward) const
+{
+    const Index n = (Index)level.A.rows();
+    for (Index k = 0; k < n; ++k)
+    {
+        const Index i = forward ? k : n - 1 - k;
+        Real sum = b[i];
+        for (typename EigenSparseMatrix::InnerIterator it(level.A, i); it; ++it)
+            if ((Index)it.col() != i)
+                sum -= it.value() * x[it.col()];
+        x[i] = sum * level.invDiag[i];
+    }
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::vcycle(AMGPreconditionerInvertData* data, std::size_t l) const
+{
+    Level& level = data->levels[l];
+    const unsigned nbSteps = d_smoothingSteps.getValue();
+
+    if (l + 1 == data->levels.size())
+    {
+        if (data->coarseFactorized)
+        {
+            level.x = data->coarseSolver.solve(level.b);
+        }
+        else
+        {
+            level.x.setZero(level.A.rows());
+            for (unsigned s = 0; s < std::max(nbSteps, 1u); ++s)
+            {
+                gaussSeidel(level, level.x, level.b, true);
+                gaussSeidel(level, level.x, level.b, false);
+            }
+        }
+        return;
+    }
+
+    level.x.setZero(level.A.rows());
+    for (unsigned s = 0; s < nbSteps; ++s)
+        gaussSeidel(level, level.x, level.b, true);
+
+    level.r = level.b - level.A * level.x;
+    Level& coarse = data->levels[l + 1];
+    coarse.b = level.R * level.r;
+    vcycle(data, l + 1);
+    level.x += level.P * coarse.x;
+
+    for (unsigned s = 0; s < nbSteps; ++s)
+        gaussSeidel(level, level.x, level.b, false);
+}
+
+template<class TMatrix, class TVector>
+void AMGPreconditioner<TMatrix,TVector>::solve (Matrix& M, Vector& z, Vector& r)
+{
+    AMGPreconditionerInvertData * data = (AMGPreconditionerInvertData *) this->getMatrixInvertData(&M);
+    if (data->levels.empty()) return;
+
+    Level& finest = data->levels[0];
+    const Index n = (Index)finest.A.rows();
+    finest.b.resize(n);
+    for (Index i = 0; i < n; ++i) finest.b[i] = r[i];
+
+    vcycle(data, 0);
+
+    for (Index i = 0; i < n; ++i) z[i] = finest.x[i];
+}
+
+} // namespace linearsolver
+
+} // namespace component
+
+} // namespace sofa
+
+#endif
@@ -74,7 +74,6 @@ public :
 protected :
     SparseLDLSolver();
 
-    FullMatrix<Real> Jminv,Jdense;
     sofa::component::linearsolver::CompressedRowSparseMatrix<Real> Mfiltered;
 };
 
@@ -31,6 +31,7 @@
 #include <cmath>
 #include <sofa/helper/system/thread/CTime.h>
 #include <SofaBaseLinearSolver/CompressedRowSparseMatrix.inl>
+#include <sofa/helper/ScratchArena.h>
 #include <fstream>
 #include <iomanip>      // std::setprecision
 #include <string>
@@ -98,9 +99,13 @@ bool SparseLDLSolver<TMatrix,TVector,TThreadManager>::addJMInvJtLocal(TMatrix *
 
     InvertData * data = (InvertData *) this->getMatrixInvertData(M);
 
+    // the dense temporaries are taken from the scratch arena of the thread, released at the end of the call
+    helper::ScratchArena& arena = helper::ScratchArena::getThreadLocal();
+    helper::ScratchArena::Scope scope(arena);
+    const std::size_t denseSize = (std::size_t)J->rowSize() * (std::size_t)data->n;
+    FullMatrix<Real> Jdense(arena.allocate<Real>(denseSize), J->rowSize(), data->n);
+    FullMatrix<Real> Jminv(arena.allocate<Real>(denseSize), J->rowSize(), data->n);
     Jdense.clear();
-    Jdense.resize(J->rowSize(),data->n);
-    Jminv.resize(J->rowSize(),data->n);
 
     for (typename SparseMatrix<Real>::LineConstIterator jit = J->begin() , jitend = J->end(); jit != jitend; ++jit) {
         int l = jit->first;